@@ -40,6 +40,7 @@ int Application::Run(HINSTANCE hInstance, int nCmdShow, LPSTR lpCmdLine) {
     // 3. 初始化核心子系统
     // 使用 std::make_unique 创建智能指针，自动管理内存
     m_game = std::make_unique<LifeGame>(gridWidth, gridHeight); // 游戏逻辑模型
+    m_game->SetCycleDetection(true); // 状态栏显示周期 (交互式网格较小，逐代哈希的开销可以忽略)
     m_renderer = std::make_unique<Renderer>(); // 渲染器
     m_ui = std::make_unique<UI>(); // UI 控制器
 
@@ -245,7 +246,10 @@ void Application::OnTimer(HWND hWnd, WPARAM timerId) {
     if (timerId == 1) // 游戏循环定时器 (ID=1)
     {
         if (m_game->IsRunning()) {
-            m_game->UpdateGrid(); // 核心逻辑：计算下一代
+            // 核心逻辑：推进本帧的代数 (最快速度下每帧多代)，统计只在最后记录一次，每帧只重绘一次
+            m_game->Step(m_game->GetGenerationsPerTick());
+            // 检测到周期并自动暂停时同步标题栏
+            if (!m_game->IsRunning()) m_ui->UpdateWindowTitle(hWnd, *m_game);
 
             // 优化重绘：
             // 之前只重绘右侧网格，导致左侧统计图不更新。
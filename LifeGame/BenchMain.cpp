@@ -0,0 +1,76 @@
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * @brief 基准测试入口 (控制台程序)
+ *
+ * 用法: LifeGameBench [-w 宽] [-h 高] [-n 代数] [-simd scalar|sse2|avx2]
+ * 默认在 CPU 支持的每个 SIMD 级别上各跑一遍。
+ */
+int main(int argc, char **argv) {
+    int width = 2000;
+    int height = 2000;
+    int generations = 100;
+    int onlyLevel = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "-cols") == 0) && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "-rows") == 0) && i + 1 < argc) {
+            height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            generations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-simd") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            if (strcmp(name, "scalar") == 0) onlyLevel = static_cast<int>(SimdLevel::Scalar);
+            else if (strcmp(name, "sse2") == 0) onlyLevel = static_cast<int>(SimdLevel::SSE2);
+            else if (strcmp(name, "avx2") == 0) onlyLevel = static_cast<int>(SimdLevel::AVX2);
+        }
+    }
+
+    const Benchmark bench(width, height, generations);
+    const int supported = static_cast<int>(DetectSimdLevel());
+    printf("Grid %dx%d, %d generations per kernel\n\n", width, height, generations);
+
+    bool allMatch = true;
+    for (int level = 0; level <= supported; level++) {
+        if (onlyLevel >= 0 && level != onlyLevel) continue;
+        const KernelTable *table = GetKernelTable(static_cast<SimdLevel>(level));
+        if (!table) continue;
+
+        const std::vector<RuleBenchmarkResult> results = bench.RunRules(table->level);
+        printf("%s\n", Benchmark::FormatReport(results, table->name).c_str());
+        for (const RuleBenchmarkResult &r: results) {
+            if (!r.resultsMatch) allMatch = false;
+        }
+    }
+
+    const KernelTable &active = GetActiveKernelTable();
+    const int maxThreads = ThreadPool::GetHardwareThreadCount();
+    const std::vector<ThreadScalingResult> scaling = bench.RunThreadScaling(active.level, maxThreads);
+    printf("Thread scaling (%s, B3/S23)\n%s\n", active.name, Benchmark::FormatReport(scaling).c_str());
+    for (const ThreadScalingResult &r: scaling) {
+        if (!r.matchesSerial) allMatch = false;
+    }
+
+    const std::vector<TemporalBlockingResult> blocking = bench.RunTemporalBlocking(active.level, maxThreads);
+    printf("\nTemporal blocking (%s, B3/S23, %d threads)\n%s\n", active.name, maxThreads,
+           Benchmark::FormatReport(blocking).c_str());
+    for (const TemporalBlockingResult &r: blocking) {
+        if (!r.matchesReference) allMatch = false;
+    }
+
+    const std::vector<ProcessScalingResult> processes = bench.RunProcessScaling(active.level, maxThreads);
+    if (!processes.empty()) {
+        printf("\nProcess scaling (%s, B3/S23, shared-memory slabs)\n%s\n", active.name,
+               Benchmark::FormatReport(processes).c_str());
+    }
+    for (const ProcessScalingResult &r: processes) {
+        if (!r.matchesSerial) allMatch = false;
+    }
+
+    // 特化内核与通用内核、多线程与单线程结果不一致时返回非 0，便于脚本检查
+    return allMatch ? 0 : 1;
+}
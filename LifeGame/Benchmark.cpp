@@ -0,0 +1,383 @@
+#include "Benchmark.h"
+#include "MultiProcessRunner.h"
+#include "RuleEngine.h"
+#include "TemporalBlocker.h"
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+Benchmark::Benchmark(int width, int height, int generations)
+    : m_width(width), m_height(height), m_generations(generations) {
+    if (m_width < 4) m_width = 4;
+    if (m_height < 4) m_height = 4;
+    if (m_generations < 1) m_generations = 1;
+}
+
+/**
+ * @brief 生成初始状态
+ *
+ * 所有测试共用同一个固定种子的初始状态，保证结果可复现。
+ */
+BitGrid Benchmark::MakeInitialGrid() const {
+    BitGrid initial;
+    initial.Resize(m_width, m_height);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> dist(0, 99);
+    for (int y = 0; y < m_height; y++) {
+        for (int x = 0; x < m_width; x++) {
+            initial.Set(x, y, dist(rng) < 40);
+        }
+    }
+    return initial;
+}
+
+/**
+ * @brief 内置非全和规则的已知构型 (中心细胞的 3x3 邻域下标，位布局见 CompiledRule)
+ */
+struct KnownPattern {
+    const char *ruleString; ///< 规则字符串
+    unsigned index; ///< 9 位邻域下标
+    bool alive; ///< 中心细胞的下一代状态
+};
+
+static const KnownPattern KNOWN_PATTERNS[] = {
+    {"B3/S2-i34q", 7 | CompiledRule::CENTER_BIT, true}, // 3i 存活
+    {"B3/S2-i34q", 130 | CompiledRule::CENTER_BIT, false}, // 2i 被排除
+    {"B3/S2-i34q", 68 | CompiledRule::CENTER_BIT, true}, // 2n 存活
+    {"B3/S2-i34q", 102 | CompiledRule::CENTER_BIT, true}, // 4q 存活
+    {"B3/S2-i34q", 78 | CompiledRule::CENTER_BIT, false}, // 4w 是 4q 的补集，不存活
+    {"B3/S2-i34q", 42, true}, // 3e 出生
+    {"B2-a/S12", 3, false}, // 2a 被排除
+    {"B2-a/S12", 5, true}, // 2c 出生
+    {"B2-a/S12", 10, true}, // 2e 出生
+    {"B2-a/S12", 40 | CompiledRule::CENTER_BIT, true}, // 2i 存活
+    {"B2-a/S12", 7 | CompiledRule::CENTER_BIT, false}, // 3 个邻居死亡
+};
+
+/**
+ * @brief 在小网格中放入单个 3x3 构型，用行内核演化一代并检查中心细胞
+ */
+static bool MatchesKnownPatterns(StepRowFn stepRow, const std::string &ruleString, const CompiledRule &rule) {
+    const int size = 8;
+    for (const KnownPattern &pattern: KNOWN_PATTERNS) {
+        if (ruleString != pattern.ruleString) continue;
+        BitGrid grid, next;
+        grid.Resize(size, size);
+        next.Resize(size, size);
+        for (int bit = 0; bit < 9; ++bit) {
+            grid.Set(2 + bit % 3, 2 + bit / 3, ((pattern.index >> bit) & 1u) != 0);
+        }
+        BoundaryHalo halo;
+        halo.Refresh(BoundaryTopology::Torus, grid);
+        StepGridRows(stepRow, grid, next, 0, size, halo, rule);
+        if (next.Get(3, 3) != pattern.alive) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 运行基准测试
+ */
+std::vector<RuleBenchmarkResult> Benchmark::RunRules(SimdLevel level) const {
+    const KernelTable *table = GetKernelTable(level);
+    if (!table) table = GetScalarKernelTable();
+
+    const BitGrid initial = MakeInitialGrid();
+
+    RuleEngine ruleEngine;
+    std::vector<RuleBenchmarkResult> results;
+    const std::vector<RuleData> &rules = ruleEngine.GetRules();
+    for (const RuleData &rule: rules) {
+        // Larger than Life 规则不走 3x3 行内核，这里不测
+        if (rule.compiled.IsLargerThanLife()) continue;
+
+        RuleBenchmarkResult r;
+        r.name = rule.name;
+        r.ruleString = rule.ruleString;
+
+        const StepRowFn specialized = SelectStepRow(*table, rule.compiled);
+        BitGrid genericGrid = initial;
+        BitGrid specializedGrid = initial;
+        if (rule.compiled.IsNonTotalistic()) {
+            // 非全和规则只有邻域表内核，与逐细胞查表的基准实现比较，并核对已知构型
+            r.hasSpecializedKernel = true;
+            r.genericMsPerGen = RunReference(rule.compiled, genericGrid);
+            r.specializedMsPerGen = Run(specialized, rule.compiled, specializedGrid);
+            r.resultsMatch = genericGrid.Equals(specializedGrid) &&
+                             MatchesKnownPatterns(specialized, rule.ruleString, rule.compiled);
+        } else {
+            r.hasSpecializedKernel = specialized != table->stepRow;
+            r.genericMsPerGen = Run(table->stepRow, rule.compiled, genericGrid);
+            r.specializedMsPerGen = Run(specialized, rule.compiled, specializedGrid);
+            r.resultsMatch = genericGrid.Equals(specializedGrid);
+        }
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * @brief 用指定行内核演化若干代
+ *
+ * 单线程，与 LifeGame::UpdateGrid 的串行路径一致 (环面幽灵细胞 + 双缓冲交换)。
+ */
+double Benchmark::Run(StepRowFn stepRow, const CompiledRule &rule, BitGrid &grid) const {
+    BitGrid next;
+    next.Resize(m_width, m_height);
+    BoundaryHalo halo;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int gen = 0; gen < m_generations; gen++) {
+        halo.Refresh(BoundaryTopology::Torus, grid);
+        StepGridRows(stepRow, grid, next, 0, m_height, halo, rule);
+        grid.Swap(next);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return totalMs / m_generations;
+}
+
+/**
+ * @brief 逐细胞查邻域表演化若干代
+ *
+ * 每个细胞直接读 9 个位置拼出邻域下标，与行内核的按字窗口、幽灵细胞实现完全独立。
+ */
+double Benchmark::RunReference(const CompiledRule &rule, BitGrid &grid) const {
+    BitGrid next;
+    next.Resize(m_width, m_height);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int gen = 0; gen < m_generations; gen++) {
+        for (int y = 0; y < m_height; y++) {
+            const int rows[3] = {(y + m_height - 1) % m_height, y, (y + 1) % m_height};
+            for (int x = 0; x < m_width; x++) {
+                const int cols[3] = {(x + m_width - 1) % m_width, x, (x + 1) % m_width};
+                unsigned index = 0;
+                for (int bit = 0; bit < 9; ++bit) {
+                    index |= static_cast<unsigned>(grid.Get(cols[bit % 3], rows[bit / 3])) << bit;
+                }
+                next.Set(x, y, rule.NextStateFromNeighborhood(index));
+            }
+        }
+        grid.Swap(next);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return totalMs / m_generations;
+}
+
+/**
+ * @brief 测试线程扩展性
+ */
+std::vector<ThreadScalingResult> Benchmark::RunThreadScaling(SimdLevel level, int maxThreads) const {
+    const KernelTable *table = GetKernelTable(level);
+    if (!table) table = GetScalarKernelTable();
+    if (maxThreads < 1) maxThreads = 1;
+
+    RuleEngine ruleEngine;
+    const CompiledRule &rule = *ruleEngine.GetCompiledRule(0);
+    const StepRowFn stepRow = SelectStepRow(*table, rule);
+    const BitGrid initial = MakeInitialGrid();
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::vector<ThreadScalingResult> results;
+    BitGrid serialGrid;
+    for (int threads: threadCounts) {
+        ThreadPool pool(threads);
+        BitGrid grid = initial;
+        ThreadScalingResult r;
+        r.threadCount = threads;
+        r.msPerGen = RunParallel(pool, stepRow, rule, grid);
+        if (threads == 1) serialGrid = grid;
+        r.matchesSerial = grid.Equals(serialGrid);
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * @brief 按分块并行演化若干代
+ *
+ * 分块与调度方式与 LifeGame::UpdateGrid 相同。
+ */
+double Benchmark::RunParallel(ThreadPool &pool, StepRowFn stepRow, const CompiledRule &rule, BitGrid &grid) const {
+    BitGrid next;
+    next.Resize(m_width, m_height);
+    TileScheduler scheduler;
+    scheduler.Resize(m_width, m_height);
+    BoundaryHalo halo;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int gen = 0; gen < m_generations; gen++) {
+        halo.Refresh(BoundaryTopology::Torus, grid);
+        scheduler.Run(pool, [&](const Tile &tile) {
+            return StepGridTile(GetActiveKernelTable(), stepRow, grid, next, tile.firstRow, tile.lastRow, tile.firstWord, tile.lastWord,
+                                halo, rule);
+        });
+        grid.Swap(next);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return totalMs / m_generations;
+}
+
+/**
+ * @brief 时间分块对比
+ *
+ * 各深度都从同一初始状态演化 m_generations 代，与逐代分块调度的结果逐位比较。
+ */
+std::vector<TemporalBlockingResult> Benchmark::RunTemporalBlocking(SimdLevel level, int threadCount) const {
+    const KernelTable *table = GetKernelTable(level);
+    if (!table) table = GetScalarKernelTable();
+
+    RuleEngine ruleEngine;
+    const CompiledRule &rule = *ruleEngine.GetCompiledRule(0);
+    const StepRowFn stepRow = SelectStepRow(*table, rule);
+    const BitGrid initial = MakeInitialGrid();
+    ThreadPool pool(threadCount);
+
+    std::vector<TemporalBlockingResult> results;
+    BitGrid reference = initial;
+    TemporalBlockingResult base;
+    base.depth = 0;
+    base.msPerGen = RunParallel(pool, stepRow, rule, reference);
+    base.matchesReference = true;
+    results.push_back(base);
+
+    for (int depth = 2; depth <= 16; depth *= 2) {
+        BitGrid grid = initial;
+        BitGrid scratch;
+        scratch.Resize(m_width, m_height);
+        TemporalBlocker blocker;
+        blocker.SetDepth(depth);
+
+        const auto start = std::chrono::steady_clock::now();
+        blocker.Run(*table, pool, stepRow, BoundaryTopology::Torus, grid, scratch, m_generations, rule);
+        const auto end = std::chrono::steady_clock::now();
+
+        TemporalBlockingResult r;
+        r.depth = depth;
+        r.msPerGen = std::chrono::duration<double, std::milli>(end - start).count() / m_generations;
+        r.matchesReference = grid.Equals(reference);
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * @brief 多进程扩展性
+ *
+ * 参照结果来自单进程串行路径 (Run)，各进程数都从同一初始状态演化 m_generations 代。
+ */
+std::vector<ProcessScalingResult> Benchmark::RunProcessScaling(SimdLevel level, int maxProcesses) const {
+    std::vector<ProcessScalingResult> results;
+    if (!MultiProcessRunner::IsAvailable()) return results;
+
+    const KernelTable *table = GetKernelTable(level);
+    if (!table) table = GetScalarKernelTable();
+    if (maxProcesses < 1) maxProcesses = 1;
+
+    RuleEngine ruleEngine;
+    const CompiledRule &rule = *ruleEngine.GetCompiledRule(0);
+    const StepRowFn stepRow = SelectStepRow(*table, rule);
+    const BitGrid initial = MakeInitialGrid();
+    BitGrid reference = initial;
+    Run(stepRow, rule, reference);
+
+    std::vector<int> processCounts;
+    for (int processes = 1; processes < maxProcesses; processes *= 2) {
+        processCounts.push_back(processes);
+    }
+    processCounts.push_back(maxProcesses);
+
+    MultiProcessRunner runner;
+    for (int processes: processCounts) {
+        BitGrid grid = initial;
+        ProcessScalingResult r;
+        const bool ok = runner.Run(stepRow, BoundaryTopology::Torus, grid, processes, m_generations, rule);
+        r.processCount = runner.GetLastProcessCount();
+        r.msPerGen = runner.GetLastElapsedMs() / m_generations;
+        r.matchesSerial = ok && grid.Equals(reference);
+        results.push_back(r);
+    }
+    return results;
+}
+
+/**
+ * @brief 格式化结果表格
+ */
+std::string Benchmark::FormatReport(const std::vector<RuleBenchmarkResult> &results, const char *kernelName) {
+    std::string report;
+    char line[160];
+    snprintf(line, sizeof(line), "Kernel: %s\n%-16s %12s %12s %9s  %s\n", kernelName,
+             "Rule", "Generic(ms)", "Special(ms)", "Speedup", "Check");
+    report += line;
+    for (const RuleBenchmarkResult &r: results) {
+        const double speedup = r.specializedMsPerGen > 0.0 ? r.genericMsPerGen / r.specializedMsPerGen : 0.0;
+        snprintf(line, sizeof(line), "%-16s %12.4f %12.4f %8.2fx  %s\n", r.ruleString.c_str(),
+                 r.genericMsPerGen, r.specializedMsPerGen, speedup,
+                 !r.hasSpecializedKernel ? "generic only" : (r.resultsMatch ? "OK" : "MISMATCH"));
+        report += line;
+    }
+    return report;
+}
+
+/**
+ * @brief 格式化线程扩展性表格
+ */
+std::string Benchmark::FormatReport(const std::vector<ThreadScalingResult> &results) {
+    std::string report = "Threads     ms/gen   Speedup  Check\n";
+    char line[160];
+    const double serialMs = results.empty() ? 0.0 : results[0].msPerGen;
+    for (const ThreadScalingResult &r: results) {
+        const double speedup = r.msPerGen > 0.0 ? serialMs / r.msPerGen : 0.0;
+        snprintf(line, sizeof(line), "%7d %10.4f %8.2fx  %s\n", r.threadCount, r.msPerGen, speedup,
+                 r.matchesSerial ? "OK" : "MISMATCH");
+        report += line;
+    }
+    return report;
+}
+
+/**
+ * @brief 格式化时间分块表格
+ */
+std::string Benchmark::FormatReport(const std::vector<TemporalBlockingResult> &results) {
+    std::string report = "Depth       ms/gen   Speedup  Check\n";
+    char line[160];
+    const double baseMs = results.empty() ? 0.0 : results[0].msPerGen;
+    for (const TemporalBlockingResult &r: results) {
+        const double speedup = r.msPerGen > 0.0 ? baseMs / r.msPerGen : 0.0;
+        if (r.depth == 0) {
+            snprintf(line, sizeof(line), "%-7s %10.4f %8.2fx  %s\n", "tiles", r.msPerGen, speedup, "reference");
+        } else {
+            snprintf(line, sizeof(line), "%7d %10.4f %8.2fx  %s\n", r.depth, r.msPerGen, speedup,
+                     r.matchesReference ? "OK" : "MISMATCH");
+        }
+        report += line;
+    }
+    return report;
+}
+
+/**
+ * @brief 格式化多进程扩展性表格
+ */
+std::string Benchmark::FormatReport(const std::vector<ProcessScalingResult> &results) {
+    std::string report = "Procs       ms/gen   Speedup  Check\n";
+    char line[160];
+    const double baseMs = results.empty() ? 0.0 : results[0].msPerGen;
+    for (const ProcessScalingResult &r: results) {
+        const double speedup = r.msPerGen > 0.0 ? baseMs / r.msPerGen : 0.0;
+        snprintf(line, sizeof(line), "%7d %10.4f %8.2fx  %s\n", r.processCount, r.msPerGen, speedup,
+                 r.matchesSerial ? "OK" : "MISMATCH");
+        report += line;
+    }
+    return report;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "SimdKernel.h"
+#include "TileScheduler.h"
+
+/**
+ * @brief 单条规则的基准测试结果
+ */
+struct RuleBenchmarkResult {
+    std::wstring name; ///< 规则名称
+    std::string ruleString; ///< 规则字符串
+    bool hasSpecializedKernel; ///< 该规则是否有特化内核
+    double genericMsPerGen; ///< 通用内核每代耗时 (毫秒)
+    double specializedMsPerGen; ///< 特化内核每代耗时 (毫秒)
+    bool resultsMatch; ///< 两种内核演化结果是否一致
+};
+
+/**
+ * @brief 某一线程数下的基准测试结果
+ */
+struct ThreadScalingResult {
+    int threadCount; ///< 线程数
+    double msPerGen; ///< 每代耗时 (毫秒)
+    bool matchesSerial; ///< 结果是否与单线程逐位一致
+};
+
+/**
+ * @brief 某一时间分块深度下的基准测试结果
+ */
+struct TemporalBlockingResult {
+    int depth; ///< 每轮推进的代数 (0 表示逐代分块调度，作为基准)
+    double msPerGen; ///< 每代耗时 (毫秒)
+    bool matchesReference; ///< 结果是否与逐代演化逐位一致
+};
+
+/**
+ * @brief 某一进程数下的多进程域分解结果
+ */
+struct ProcessScalingResult {
+    int processCount; ///< 工作进程数
+    double msPerGen; ///< 每代耗时 (毫秒，不含创建共享内存与 fork)
+    bool matchesSerial; ///< 结果是否与单进程逐代演化逐位一致
+};
+
+/**
+ * @brief 演化内核基准测试
+ *
+ * 对每条内置规则，从同一个随机初始状态出发，分别用通用内核与特化内核演化若干代，
+ * 记录每代耗时并校验两者结果逐位一致。
+ * 只计时行内核本身 (环绕取行 + 内核调用 + 交换缓冲)，不包含统计、渲染等开销。
+ */
+class Benchmark {
+public:
+    /**
+     * @brief 构造函数
+     * @param width 网格宽度
+     * @param height 网格高度
+     * @param generations 每个内核演化的代数
+     */
+    Benchmark(int width, int height, int generations);
+
+    /**
+     * @brief 对全部内置规则运行基准测试
+     * @param level 使用的 SIMD 级别 (不得高于 DetectSimdLevel() 的结果)
+     * @return std::vector<RuleBenchmarkResult> 每条规则一项
+     */
+    std::vector<RuleBenchmarkResult> RunRules(SimdLevel level) const;
+
+    /**
+     * @brief 测试多线程分块并行的扩展性 (Conway 规则)
+     *
+     * 线程数依次取 1, 2, 4, ... 直到 maxThreads (含 maxThreads 本身)。
+     * @param level 使用的 SIMD 级别
+     * @param maxThreads 最大线程数
+     * @return std::vector<ThreadScalingResult> 每个线程数一项
+     */
+    std::vector<ThreadScalingResult> RunThreadScaling(SimdLevel level, int maxThreads) const;
+
+    /**
+     * @brief 比较时间分块与逐代演化 (Conway 规则，环面)
+     *
+     * 第一项为逐代分块调度 (与 LifeGame::UpdateGrid 相同)，之后依次为深度 2, 4, 8, 16 的时间分块。
+     * @param level 使用的 SIMD 级别
+     * @param threadCount 线程数
+     * @return std::vector<TemporalBlockingResult> 每个深度一项
+     */
+    std::vector<TemporalBlockingResult> RunTemporalBlocking(SimdLevel level, int threadCount) const;
+
+    /**
+     * @brief 测试多进程域分解的扩展性 (Conway 规则，环面)
+     *
+     * 进程数依次取 1, 2, 4, ... 直到 maxProcesses (含 maxProcesses 本身)，每个进程单线程演化自己的条块，
+     * 结果与单进程串行演化比较。当前平台不支持多进程时返回空表。
+     * @param level 使用的 SIMD 级别
+     * @param maxProcesses 最大进程数
+     * @return std::vector<ProcessScalingResult> 每个进程数一项
+     */
+    std::vector<ProcessScalingResult> RunProcessScaling(SimdLevel level, int maxProcesses) const;
+
+    /**
+     * @brief 把结果格式化为文本表格
+     */
+    static std::string FormatReport(const std::vector<RuleBenchmarkResult> &results, const char *kernelName);
+
+    /**
+     * @brief 把线程扩展性结果格式化为文本表格
+     */
+    static std::string FormatReport(const std::vector<ThreadScalingResult> &results);
+
+    /**
+     * @brief 把时间分块结果格式化为文本表格
+     */
+    static std::string FormatReport(const std::vector<TemporalBlockingResult> &results);
+
+    /**
+     * @brief 把多进程扩展性结果格式化为文本表格
+     */
+    static std::string FormatReport(const std::vector<ProcessScalingResult> &results);
+
+private:
+    /**
+     * @brief 生成固定种子的随机初始状态 (40% 密度)
+     */
+    BitGrid MakeInitialGrid() const;
+
+    /**
+     * @brief 用指定行内核演化 m_generations 代
+     * @return double 每代平均耗时 (毫秒)
+     */
+    double Run(StepRowFn stepRow, const CompiledRule &rule, BitGrid &grid) const;
+
+    /**
+     * @brief 逐细胞读 3x3 邻域、查 rule.neighborhood 演化 m_generations 代 (环面)
+     *
+     * 不经过任何行内核，作为非全和规则邻域表内核的比较基准。
+     * @return double 每代平均耗时 (毫秒)
+     */
+    double RunReference(const CompiledRule &rule, BitGrid &grid) const;
+
+    /**
+     * @brief 用线程池按分块并行演化 m_generations 代
+     * @return double 每代平均耗时 (毫秒)
+     */
+    double RunParallel(ThreadPool &pool, StepRowFn stepRow, const CompiledRule &rule, BitGrid &grid) const;
+
+    int m_width; ///< 网格宽度
+    int m_height; ///< 网格高度
+    int m_generations; ///< 演化代数
+};
@@ -0,0 +1,257 @@
+#include "BitGrid.h"
+#include "SimdKernel.h"
+#include "BitOps.h"
+#include "Xoshiro256.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief 默认构造函数 (空网格)
+ */
+BitGrid::BitGrid()
+    : m_words(nullptr), m_width(0), m_height(0), m_wordsPerRow(0), m_stride(0), m_lastWordMask(0) {
+}
+
+/**
+ * @brief 构造函数
+ */
+BitGrid::BitGrid(int width, int height)
+    : m_words(nullptr), m_width(0), m_height(0), m_wordsPerRow(0), m_stride(0), m_lastWordMask(0) {
+    Allocate(width, height);
+}
+
+/**
+ * @brief 拷贝构造 (深拷贝)
+ */
+BitGrid::BitGrid(const BitGrid &other)
+    : m_words(nullptr), m_width(0), m_height(0), m_wordsPerRow(0), m_stride(0), m_lastWordMask(0) {
+    Allocate(other.m_width, other.m_height);
+    if (m_words && other.m_words) {
+        std::memcpy(m_words, other.m_words, GetMemoryBytes());
+    }
+}
+
+/**
+ * @brief 移动构造
+ */
+BitGrid::BitGrid(BitGrid &&other) noexcept
+    : m_words(nullptr), m_width(0), m_height(0), m_wordsPerRow(0), m_stride(0), m_lastWordMask(0) {
+    Swap(other);
+}
+
+BitGrid &BitGrid::operator=(const BitGrid &other) {
+    if (this != &other) {
+        BitGrid copy(other);
+        Swap(copy);
+    }
+    return *this;
+}
+
+BitGrid &BitGrid::operator=(BitGrid &&other) noexcept {
+    if (this != &other) {
+        BitGrid empty;
+        Swap(empty);
+        Swap(other);
+    }
+    return *this;
+}
+
+BitGrid::~BitGrid() {
+}
+
+/**
+ * @brief 分配对齐的缓冲区并清零
+ *
+ * 额外多分配一个对齐单位，再把首地址向上调整到 64 字节边界。
+ */
+void BitGrid::Allocate(int width, int height) {
+    if (width < 0) width = 0;
+    if (height < 0) height = 0;
+
+    const int wordsPerRow = WordsForWidth(width);
+    const int stride = (wordsPerRow + STRIDE_ALIGN_WORDS - 1) / STRIDE_ALIGN_WORDS * STRIDE_ALIGN_WORDS;
+    const size_t alignWords = MEMORY_ALIGN_BYTES / sizeof(uint64_t);
+    const size_t totalWords = static_cast<size_t>(stride) * height + alignWords;
+
+    std::unique_ptr<uint64_t[]> storage(new uint64_t[totalWords]());
+    uintptr_t addr = reinterpret_cast<uintptr_t>(storage.get());
+    uintptr_t aligned = (addr + MEMORY_ALIGN_BYTES - 1) & ~static_cast<uintptr_t>(MEMORY_ALIGN_BYTES - 1);
+
+    m_storage = std::move(storage);
+    m_words = reinterpret_cast<uint64_t *>(aligned);
+    m_width = width;
+    m_height = height;
+    m_wordsPerRow = wordsPerRow;
+    m_stride = stride;
+
+    const int tailBits = width % WORD_BITS;
+    m_lastWordMask = (tailBits == 0) ? ~0ULL : ((1ULL << tailBits) - 1);
+}
+
+void BitGrid::Resize(int width, int height) {
+    Allocate(width, height);
+}
+
+void BitGrid::Clear() {
+    if (m_words) {
+        std::memset(m_words, 0, GetMemoryBytes());
+    }
+}
+
+void BitGrid::Swap(BitGrid &other) noexcept {
+    std::swap(m_storage, other.m_storage);
+    std::swap(m_words, other.m_words);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    std::swap(m_wordsPerRow, other.m_wordsPerRow);
+    std::swap(m_stride, other.m_stride);
+    std::swap(m_lastWordMask, other.m_lastWordMask);
+}
+
+/**
+ * @brief 统计活细胞数量
+ *
+ * 依赖 "填充位为 0" 的不变量，直接对每个有效字做 popcount。
+ */
+long long BitGrid::CountPopulation() const {
+    return CountPopulation(GetActiveKernelTable());
+}
+
+long long BitGrid::CountPopulation(const KernelTable &kernels) const {
+    long long count = 0;
+    for (int y = 0; y < m_height; ++y) {
+        count += kernels.countBits(GetRow(y), m_wordsPerRow);
+    }
+    return count;
+}
+
+/**
+ * @brief 反转所有细胞
+ */
+void BitGrid::Invert() {
+    Invert(GetActiveKernelTable());
+}
+
+void BitGrid::Invert(const KernelTable &kernels) {
+    if (m_wordsPerRow == 0) return;
+    for (int y = 0; y < m_height; ++y) {
+        uint64_t *row = GetRow(y);
+        kernels.invertWords(row, m_wordsPerRow);
+        row[m_wordsPerRow - 1] &= m_lastWordMask;
+    }
+}
+
+/**
+ * @brief 填充矩形区域
+ *
+ * 每行按 [x0, x1) 计算首尾字掩码，中间的整字直接写入。
+ */
+void BitGrid::FillRect(int x, int y, int w, int h, bool state) {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + w, m_width);
+    int y1 = std::min(y + h, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const int firstWord = x0 >> 6;
+    const int lastWord = (x1 - 1) >> 6;
+    const uint64_t firstMask = ~0ULL << (x0 & 63);
+    const uint64_t lastMask = ~0ULL >> (63 - ((x1 - 1) & 63));
+
+    for (int yy = y0; yy < y1; ++yy) {
+        uint64_t *row = GetRow(yy);
+        for (int i = firstWord; i <= lastWord; ++i) {
+            uint64_t mask = ~0ULL;
+            if (i == firstWord) mask &= firstMask;
+            if (i == lastWord) mask &= lastMask;
+            if (state) row[i] |= mask;
+            else row[i] &= ~mask;
+        }
+    }
+}
+
+/**
+ * @brief 随机填充矩形区域
+ *
+ * 与 FillRect 相同的首尾字掩码，区域外的位保持不变。
+ */
+void BitGrid::FillRandom(int x, int y, int w, int h, float density, Xoshiro256 &rng) {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + w, m_width);
+    int y1 = std::min(y + h, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const unsigned threshold = Xoshiro256::DensityToThreshold(density);
+    const int firstWord = x0 >> 6;
+    const int lastWord = (x1 - 1) >> 6;
+    const uint64_t firstMask = ~0ULL << (x0 & 63);
+    const uint64_t lastMask = ~0ULL >> (63 - ((x1 - 1) & 63));
+
+    for (int yy = y0; yy < y1; ++yy) {
+        uint64_t *row = GetRow(yy);
+        for (int i = firstWord; i <= lastWord; ++i) {
+            uint64_t mask = ~0ULL;
+            if (i == firstWord) mask &= firstMask;
+            if (i == lastWord) mask &= lastMask;
+            row[i] = (row[i] & ~mask) | (rng.NextBernoulli(threshold) & mask);
+        }
+    }
+}
+
+/**
+ * @brief 提取矩形区域
+ */
+void BitGrid::ExtractRegion(int x, int y, int w, int h, BitGrid &out) const {
+    out.Resize(w, h);
+    for (int dy = 0; dy < h; ++dy) {
+        int sy = y + dy;
+        if (sy < 0 || sy >= m_height) continue;
+        for (int dx = 0; dx < w; ++dx) {
+            int sx = x + dx;
+            if (sx < 0 || sx >= m_width) continue;
+            if (Get(sx, sy)) out.Set(dx, dy, true);
+        }
+    }
+}
+
+/**
+ * @brief 粘贴区域 (覆盖写入)
+ */
+void BitGrid::PasteRegion(int x, int y, const BitGrid &src) {
+    for (int dy = 0; dy < src.GetHeight(); ++dy) {
+        int ty = y + dy;
+        if (ty < 0 || ty >= m_height) continue;
+        for (int dx = 0; dx < src.GetWidth(); ++dx) {
+            int tx = x + dx;
+            if (tx < 0 || tx >= m_width) continue;
+            Set(tx, ty, src.Get(dx, dy));
+        }
+    }
+}
+
+/**
+ * @brief 比较两个网格
+ */
+bool BitGrid::Equals(const BitGrid &other) const {
+    if (m_width != other.m_width || m_height != other.m_height) return false;
+    for (int y = 0; y < m_height; ++y) {
+        if (std::memcmp(GetRow(y), other.GetRow(y), m_wordsPerRow * sizeof(uint64_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BitGrid::CountChanges(const BitGrid &previous, long long &births, long long &deaths) const {
+    births = 0;
+    deaths = 0;
+    for (int y = 0; y < m_height; ++y) {
+        const uint64_t *now = GetRow(y);
+        const uint64_t *before = previous.GetRow(y);
+        for (int i = 0; i < m_wordsPerRow; ++i) {
+            births += PopCount64(now[i] & ~before[i]);
+            deaths += PopCount64(before[i] & ~now[i]);
+        }
+    }
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+struct KernelTable;
+class Xoshiro256;
+
+/**
+ * @brief 位平面网格 (Bit-Plane Grid)
+ *
+ * 以 64 位字为单位紧凑存储细胞状态，每个细胞只占 1 bit。
+ * 所有行存放在同一块连续的、按 64 字节对齐的内存中，行与行之间以固定步长 (Stride) 排列。
+ * 步长向上取整到 4 个字 (32 字节)，为按 SIMD 宽度批量处理预留空间。
+ *
+ * 位布局：第 y 行第 x 列的细胞位于 GetRow(y)[x / 64] 的第 (x % 64) 位。
+ *
+ * 不变量：每行最后一个有效字中超出宽度的填充位 (Padding Bits) 以及步长中多余的填充字始终为 0，
+ * 因此按字统计人口或比较两行时无需额外掩码。
+ */
+class BitGrid {
+public:
+    static constexpr int WORD_BITS = 64; ///< 每个字包含的细胞数
+    static constexpr int STRIDE_ALIGN_WORDS = 4; ///< 行步长对齐 (字)
+    static constexpr size_t MEMORY_ALIGN_BYTES = 64; ///< 缓冲区起始地址对齐 (字节)
+
+    BitGrid();
+
+    /**
+     * @brief 构造函数
+     * @param width 网格宽度 (细胞)
+     * @param height 网格高度 (细胞)
+     */
+    BitGrid(int width, int height);
+
+    BitGrid(const BitGrid &other);
+
+    BitGrid(BitGrid &&other) noexcept;
+
+    BitGrid &operator=(const BitGrid &other);
+
+    BitGrid &operator=(BitGrid &&other) noexcept;
+
+    ~BitGrid();
+
+    /**
+     * @brief 调整网格大小
+     *
+     * 重新分配缓冲区，所有细胞被清零。
+     * @param width 新宽度
+     * @param height 新高度
+     */
+    void Resize(int width, int height);
+
+    /**
+     * @brief 清空所有细胞
+     */
+    void Clear();
+
+    /**
+     * @brief 与另一个网格交换缓冲区
+     *
+     * 仅交换指针和尺寸信息，时间复杂度 O(1)，用于双缓冲翻转。
+     */
+    void Swap(BitGrid &other) noexcept;
+
+    // ==========================================
+    // 单细胞访问 (Cell Access)
+    // ==========================================
+
+    /**
+     * @brief 读取细胞 (不做边界检查)
+     */
+    bool Get(int x, int y) const {
+        return ((m_words[static_cast<size_t>(y) * m_stride + (x >> 6)] >> (x & 63)) & 1ULL) != 0;
+    }
+
+    /**
+     * @brief 写入细胞 (不做边界检查)
+     */
+    void Set(int x, int y, bool state) {
+        uint64_t &word = m_words[static_cast<size_t>(y) * m_stride + (x >> 6)];
+        const uint64_t bit = 1ULL << (x & 63);
+        if (state) word |= bit;
+        else word &= ~bit;
+    }
+
+    // ==========================================
+    // 字级访问 (Word Access)
+    // ==========================================
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetWordsPerRow() const { return m_wordsPerRow; } ///< 每行有效字数
+    int GetStride() const { return m_stride; } ///< 行步长 (字)，包含对齐填充
+
+    /**
+     * @brief 获取第 y 行首字指针
+     */
+    uint64_t *GetRow(int y) { return m_words + static_cast<size_t>(y) * m_stride; }
+    const uint64_t *GetRow(int y) const { return m_words + static_cast<size_t>(y) * m_stride; }
+
+    /**
+     * @brief 获取每行最后一个有效字的掩码
+     *
+     * 掩码中为 1 的位对应真实细胞，为 0 的位是填充位。
+     */
+    uint64_t GetLastWordMask() const { return m_lastWordMask; }
+
+    /**
+     * @brief 缓冲区占用的字节数 (包含填充)
+     */
+    size_t GetMemoryBytes() const { return static_cast<size_t>(m_stride) * m_height * sizeof(uint64_t); }
+
+    // ==========================================
+    // 批量操作 (Bulk Operations)
+    // ==========================================
+
+    /**
+     * @brief 统计活细胞数量
+     *
+     * 默认使用启动时选出的最佳 SIMD 实现，也可以显式指定函数表。
+     */
+    long long CountPopulation() const;
+
+    long long CountPopulation(const KernelTable &kernels) const;
+
+    /**
+     * @brief 反转所有细胞 (保持填充位为 0)
+     */
+    void Invert();
+
+    void Invert(const KernelTable &kernels);
+
+    /**
+     * @brief 将矩形区域填充为指定状态
+     *
+     * 区域会被裁剪到网格范围内，中间整字直接写入。
+     */
+    void FillRect(int x, int y, int w, int h, bool state);
+
+    /**
+     * @brief 按密度随机填充矩形区域
+     *
+     * 每次抽取一次生成一个字的 64 个细胞 (见 Xoshiro256::NextBernoulli)，按字写入，区域会被裁剪到网格范围内。
+     * 同一生成器状态与参数总是得到相同的结果。
+     * @param density 活细胞概率 (0 - 1，精确到 1/256)
+     * @param rng 随机数生成器
+     */
+    void FillRandom(int x, int y, int w, int h, float density, Xoshiro256 &rng);
+
+    /**
+     * @brief 提取矩形区域到另一个网格
+     *
+     * 区域中超出本网格范围的部分视为死细胞。
+     * @param out 输出网格，将被调整为 w x h
+     */
+    void ExtractRegion(int x, int y, int w, int h, BitGrid &out) const;
+
+    /**
+     * @brief 将另一个网格的内容覆盖写入到指定位置 (自动裁剪)
+     */
+    void PasteRegion(int x, int y, const BitGrid &src);
+
+    /**
+     * @brief 判断两个网格内容是否完全一致
+     */
+    bool Equals(const BitGrid &other) const;
+
+    /**
+     * @brief 与之前的状态比较，统计出生 (0 -> 1) 与死亡 (1 -> 0) 的细胞数
+     *
+     * 两个网格尺寸必须相同。
+     */
+    void CountChanges(const BitGrid &previous, long long &births, long long &deaths) const;
+
+    /**
+     * @brief 计算宽度对应的每行字数
+     */
+    static int WordsForWidth(int width) { return (width + WORD_BITS - 1) / WORD_BITS; }
+
+    /**
+     * @brief 计算指定尺寸的网格实际分配的字节数 (含步长填充与对齐余量)，用于分配前的内存预算检查
+     */
+    static unsigned long long BytesFor(int width, int height) {
+        const unsigned long long stride = (WordsForWidth(width) + STRIDE_ALIGN_WORDS - 1) / STRIDE_ALIGN_WORDS *
+                                          STRIDE_ALIGN_WORDS;
+        return (stride * height) * sizeof(uint64_t) + MEMORY_ALIGN_BYTES;
+    }
+
+private:
+    void Allocate(int width, int height);
+
+    std::unique_ptr<uint64_t[]> m_storage; ///< 原始分配 (含对齐余量)
+    uint64_t *m_words; ///< 对齐后的首字地址
+    int m_width;
+    int m_height;
+    int m_wordsPerRow;
+    int m_stride;
+    uint64_t m_lastWordMask;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief 位运算辅助函数 (Bit Operations)
+ *
+ * 提供与编译器无关的 64 位字级位操作，供位平面网格及其演化内核使用。
+ */
+
+/**
+ * @brief 统计 64 位字中置 1 的位数 (Population Count)
+ *
+ * 使用可移植的 SWAR 实现，不依赖 POPCNT 指令，可在任意 x86/x64 CPU 上运行。
+ * 演化内核中逐代的细胞计数经 KernelTable::accumulateCounts 分派，CPU 支持时使用 POPCNT 指令。
+ */
+inline int PopCount64(uint64_t v) {
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((v * 0x0101010101010101ULL) >> 56);
+}
+
+/**
+ * @brief 一块区域在一代中的细胞计数
+ */
+struct CellCounts {
+    long long population; ///< 下一代的活细胞数
+    long long births; ///< 出生 (0 -> 1) 的细胞数
+    long long deaths; ///< 死亡 (1 -> 0) 的细胞数
+};
+
+/**
+ * @brief 把一个字的前后两代计入细胞计数
+ *
+ * 出生为 after & ~before，死亡为 before & ~after。空白字与未变化的字走捷径，稀疏或稳定的区域几乎没有额外开销。
+ */
+inline void AccumulateCellCounts(uint64_t before, uint64_t after, CellCounts &counts) {
+    if (after == before) {
+        if (after != 0) counts.population += PopCount64(after);
+        return;
+    }
+    counts.population += PopCount64(after);
+    counts.births += PopCount64(after & ~before);
+    counts.deaths += PopCount64(before & ~after);
+}
+
+/**
+ * @brief 计算 64 位字末尾 0 的个数 (Count Trailing Zeros)
+ *
+ * @param v 输入值，调用方需保证 v != 0
+ * @return int 最低置位的下标 (0-63)
+ */
+inline int CountTrailingZeros64(uint64_t v) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while ((v & 1ULL) == 0) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief 计算 64 位字开头 0 的个数 (Count Leading Zeros)
+ *
+ * @param v 输入值，调用方需保证 v != 0
+ * @return int 最高置位之上的 0 的个数 (最高置位的下标为 63 - 返回值)
+ */
+inline int CountLeadingZeros64(uint64_t v) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, v);
+    return 63 - static_cast<int>(index);
+#elif defined(__GNUC__)
+    return __builtin_clzll(v);
+#else
+    int n = 0;
+    while ((v & (1ULL << 63)) == 0) {
+        v <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
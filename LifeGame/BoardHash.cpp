@@ -0,0 +1,83 @@
+#include "BoardHash.h"
+#include <cstring>
+
+BoardHash::BoardHash() : m_value(0), m_valid(false) {
+}
+
+void BoardHash::Resize(int tileCount) {
+    m_tileHashes.assign(tileCount, 0);
+    m_staged.assign(tileCount, 0);
+    m_value = 0;
+    m_valid = false;
+}
+
+/**
+ * @brief SplitMix64 的终结函数：把 64 位输入打散为均匀分布的输出
+ */
+static uint64_t Mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 分块哈希
+ *
+ * 每个字按它在整个网格中的下标加盐，同样的图案出现在不同位置哈希也不同；全零的字不参与。
+ */
+uint64_t BoardHash::HashTile(const BitGrid &grid, const StateGrid *states, const Tile &tile) {
+    const uint64_t wordsPerRow = static_cast<uint64_t>(grid.GetWordsPerRow());
+    uint64_t hash = 0;
+    for (int y = tile.firstRow; y < tile.lastRow; ++y) {
+        const uint64_t *row = grid.GetRow(y);
+        for (int w = tile.firstWord; w < tile.lastWord; ++w) {
+            if (row[w] == 0) continue;
+            const uint64_t index = static_cast<uint64_t>(y) * wordsPerRow + w;
+            hash ^= Mix64(row[w] + index * 0x9E3779B97F4A7C15ULL);
+        }
+    }
+    if (states == nullptr) return hash;
+
+    // 状态平面按 8 个字节一组混合 (盐与位平面不同)
+    const int width = grid.GetWidth();
+    const int firstX = tile.firstWord * BitGrid::WORD_BITS;
+    const int lastX = tile.lastWord * BitGrid::WORD_BITS < width ? tile.lastWord * BitGrid::WORD_BITS : width;
+    for (int y = tile.firstRow; y < tile.lastRow; ++y) {
+        const uint8_t *row = states->GetRow(y);
+        for (int x = firstX; x < lastX; x += 8) {
+            uint64_t chunk = 0;
+            memcpy(&chunk, row + x, lastX - x < 8 ? lastX - x : 8);
+            if (chunk == 0) continue;
+            const uint64_t index = static_cast<uint64_t>(y) * width + x;
+            hash ^= Mix64(chunk + index * 0xD6E8FEB86659FD93ULL + 0x632BE59BD9B4E019ULL);
+        }
+    }
+    return hash;
+}
+
+void BoardHash::Rebuild(ThreadPool &pool, const BitGrid &grid, const StateGrid *states,
+                        const std::vector<Tile> &tiles) {
+    if (m_tileHashes.size() != tiles.size()) Resize(static_cast<int>(tiles.size()));
+    pool.Run(static_cast<int>(tiles.size()), [&](int index) {
+        m_tileHashes[index] = HashTile(grid, states, tiles[index]);
+    });
+    m_value = 0;
+    for (uint64_t h: m_tileHashes) {
+        m_value ^= h;
+    }
+    m_valid = true;
+}
+
+/**
+ * @brief 合并变化分块的哈希
+ *
+ * 未变化的分块在前后缓冲中内容相同 (见 TileScheduler)，原有哈希仍然有效。
+ */
+void BoardHash::Commit(const TileScheduler &scheduler) {
+    const int tileCount = scheduler.GetTileCount();
+    for (int i = 0; i < tileCount; ++i) {
+        if (!scheduler.HasTileChanged(i)) continue;
+        m_value ^= m_tileHashes[i] ^ m_staged[i];
+        m_tileHashes[i] = m_staged[i];
+    }
+}
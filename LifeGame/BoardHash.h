@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BitGrid.h"
+#include "StateGrid.h"
+#include "ThreadPool.h"
+#include "TileScheduler.h"
+
+/**
+ * @brief 增量棋盘哈希
+ *
+ * 棋盘哈希是各分块哈希的异或，分块哈希又是块内每个非零字 (按它在网格中的位置加盐后混合) 的异或，
+ * 空棋盘的哈希为 0。Generations 规则下再混入状态平面，衰减态不同的棋盘哈希也不同。
+ *
+ * 演化时各分块任务在写完自己的结果后顺便计算新的分块哈希 (StageTile)，
+ * 一代结束后只对本代变化的分块把旧值异或掉、新值异或进来 (Commit)，代价与变化区域成正比。
+ * 棋盘被直接编辑后调用 Invalidate，下次使用前整体重建一次。
+ */
+class BoardHash {
+public:
+    BoardHash();
+
+    /**
+     * @brief 按分块数重新分配 (哈希随之失效)
+     */
+    void Resize(int tileCount);
+
+    /**
+     * @brief 标记哈希失效 (棋盘被直接编辑、规则或拓扑改变等)
+     */
+    void Invalidate() { m_valid = false; }
+
+    bool IsValid() const { return m_valid; }
+
+    uint64_t GetValue() const { return m_value; }
+
+    /**
+     * @brief 计算一个分块的哈希
+     * @param states Generations 规则的状态平面，两态规则传 nullptr
+     */
+    static uint64_t HashTile(const BitGrid &grid, const StateGrid *states, const Tile &tile);
+
+    /**
+     * @brief 用线程池重新计算全部分块的哈希
+     */
+    void Rebuild(ThreadPool &pool, const BitGrid &grid, const StateGrid *states, const std::vector<Tile> &tiles);
+
+    /**
+     * @brief 暂存分块的新哈希 (由各分块任务并行调用，互不干扰)
+     */
+    void StageTile(const Tile &tile, uint64_t hash) { m_staged[tile.index] = hash; }
+
+    /**
+     * @brief 把上一次 Run 中变化了的分块的暂存哈希并入棋盘哈希
+     */
+    void Commit(const TileScheduler &scheduler);
+
+private:
+    std::vector<uint64_t> m_tileHashes; ///< 各分块当前的哈希
+    std::vector<uint64_t> m_staged; ///< 本代各分块的新哈希 (只有变化的分块有效)
+    uint64_t m_value; ///< 棋盘哈希 (全部分块哈希的异或)
+    bool m_valid; ///< 哈希是否与棋盘一致
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Larger than Life 规则参数
+ *
+ * 半径 R 的邻域内活细胞数落在区间内即出生/存活，例如 "R5,C0,M1,S34..58,B34..45,NM"。
+ */
+struct LtlRule {
+    uint8_t radius; ///< 邻域半径 (0 表示不是 LtL 规则，走普通 3x3 内核)
+    bool vonNeumann; ///< true = 菱形邻域 (曼哈顿距离 <= R，NN)，false = 正方形邻域 (Moore，NM)
+    bool countCenter; ///< 中心细胞自身是否计入邻居数 (M1)
+    uint16_t birthMin; ///< 出生的邻居数下限
+    uint16_t birthMax; ///< 出生的邻居数上限 (含)
+    uint16_t survivalMin; ///< 存活的邻居数下限
+    uint16_t survivalMax; ///< 存活的邻居数上限 (含)
+
+    static constexpr int MAX_RADIUS = 10; ///< 支持的最大半径
+};
+
+/**
+ * @brief 邻域网络的一个节点：按邻域下标的某一位在两个子函数之间选择
+ *
+ * low/high 是子函数在求值数组中的下标：0 为常量 0，1 为常量 1，k + 2 为第 k 个节点的结果。
+ */
+struct NeighborhoodNode {
+    uint8_t var; ///< 邻域下标中的位 (0-8，位布局见 CompiledRule)
+    uint8_t low; ///< 该位为 0 时的子函数
+    uint8_t high; ///< 该位为 1 时的子函数
+};
+
+/**
+ * @brief 512 位邻域表的布尔网络
+ *
+ * RuleEngine 对邻域表做香农展开，并合并真值相同的子函数 (化简的二叉决策图)。
+ * 节点按子节点在前的顺序排列，依次对整字 (或整个向量) 求值，一次得到其中全部细胞的下一状态，
+ * 不再逐细胞拼下标查表。9 个变量的化简决策图至多 141 个节点。
+ */
+struct NeighborhoodNetwork {
+    static constexpr int MAX_NODES = 144; ///< 节点数上限
+
+    bool built; ///< 是否已生成 (未生成时行内核逐细胞查表)
+    uint8_t nodeCount; ///< 节点数
+    uint8_t output; ///< 网络输出在求值数组中的下标
+    NeighborhoodNode nodes[MAX_NODES]; ///< 节点 (子节点在前)
+};
+
+/**
+ * @brief 预编译规则 (Compiled Rule)
+ *
+ * 由 RuleEngine 把 RuleData 中的出生/存活集合编译成紧凑的转移表，
+ * 演化内核直接按位查表，不再做 std::set 查找或规则索引的边界检查。
+ *
+ * 包含两种形式：
+ * 1. 18 位转移掩码：适用于外部全和 (Outer-Totalistic) 的 B/S 规则，位并行内核直接使用；
+ * 2. 512 位邻域表：以完整 3x3 邻域为下标，可表达非全和 (Non-Totalistic) 规则。
+ *
+ * 非全和规则 (Hensel 记法，例如 "B2-a3/S23") 只能用邻域表演化，nonTotalistic 为 true；
+ * 此时转移掩码只记录 "该邻居数下所有构型都出生/存活" 的邻居数，仅供显示与兼容。
+ *
+ * 另外记录状态数：2 为普通 B/S 规则；大于 2 为 Generations 规则，
+ * 此时只有状态 1 是 "活" 的 (参与邻居计数)，不满足存活条件的活细胞依次经过 2 .. states-1 的衰减态后死亡，
+ * 衰减中的细胞既不计入邻居，也不能出生。
+ *
+ * 3x3 邻域下标的位布局 (按行优先)：
+ *   bit0 西北  bit1 北  bit2 东北
+ *   bit3 西    bit4 中心 bit5 东
+ *   bit6 西南  bit7 南  bit8 东南
+ */
+struct CompiledRule {
+    static constexpr int SURVIVAL_SHIFT = 9; ///< 存活掩码在转移掩码中的起始位
+    static constexpr unsigned CENTER_BIT = 1u << 4; ///< 邻域下标中中心细胞所在的位
+
+    /**
+     * @brief 18 位转移掩码
+     *
+     * 第 n 位 (0-8) 为 1 表示死细胞有 n 个活邻居时出生；
+     * 第 9+n 位为 1 表示活细胞有 n 个活邻居时存活。
+     */
+    uint32_t transitions;
+
+    /**
+     * @brief 512 位邻域转移表 (8 个 64 位字)
+     *
+     * 第 idx 位为下标 idx 的 3x3 邻域在下一代的中心状态。
+     */
+    uint64_t neighborhood[8];
+
+    uint8_t states; ///< 状态数 (2 = 普通 B/S 规则，大于 2 = Generations 规则)
+
+    bool nonTotalistic; ///< 是否为非全和规则 (必须使用 512 位邻域表)
+
+    NeighborhoodNetwork network; ///< 邻域表对应的布尔网络 (只为非全和规则生成)
+
+    /**
+     * @brief Larger than Life 参数
+     *
+     * 半径为 1 的 Moore 邻域规则在编译时直接折算为上面的转移掩码，此时 radius 为 0。
+     */
+    LtlRule ltl;
+
+    bool IsGenerations() const { return states > 2; }
+
+    bool IsLargerThanLife() const { return ltl.radius > 0; }
+
+    bool IsNonTotalistic() const { return nonTotalistic; }
+
+    uint16_t GetBirthMask() const { return static_cast<uint16_t>(transitions & 0x1FF); }
+    uint16_t GetSurvivalMask() const { return static_cast<uint16_t>((transitions >> SURVIVAL_SHIFT) & 0x1FF); }
+
+    /**
+     * @brief 按邻居数查询下一状态
+     */
+    bool NextState(bool alive, int neighbors) const {
+        return ((transitions >> (neighbors + (alive ? SURVIVAL_SHIFT : 0))) & 1u) != 0;
+    }
+
+    /**
+     * @brief 按 3x3 邻域下标查询下一状态
+     */
+    bool NextStateFromNeighborhood(unsigned index) const {
+        return ((neighborhood[index >> 6] >> (index & 63)) & 1ULL) != 0;
+    }
+};
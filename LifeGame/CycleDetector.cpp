@@ -0,0 +1,74 @@
+#include "CycleDetector.h"
+
+CycleDetector::CycleDetector()
+    : m_active(false), m_tortoise(0), m_power(1), m_lambda(0), m_firstGeneration(0), m_lastGeneration(0) {
+    m_info = CycleInfo();
+}
+
+void CycleDetector::Reset(uint64_t hash, long long generation) {
+    // 历史按需分配：不开启检测时不占内存
+    if (m_history.empty()) m_history.assign(HISTORY_SIZE, 0);
+    m_active = true;
+    m_tortoise = hash;
+    m_power = 1;
+    m_lambda = 0;
+    m_firstGeneration = generation;
+    m_lastGeneration = generation;
+    HistoryAt(generation) = static_cast<uint32_t>(hash);
+    m_info = CycleInfo();
+}
+
+void CycleDetector::Clear() {
+    m_active = false;
+    m_info = CycleInfo();
+}
+
+/**
+ * @brief Brent 算法的一步
+ *
+ * 已经检测到周期后仍然记录指纹，但不再比较 (确定性演化不会离开周期)。
+ */
+bool CycleDetector::Observe(uint64_t hash, long long generation) {
+    if (!m_active || generation != m_lastGeneration + 1) {
+        Reset(hash, generation);
+        return false;
+    }
+    m_lastGeneration = generation;
+    HistoryAt(generation) = static_cast<uint32_t>(hash);
+    if (m_info.detected) return false;
+
+    m_lambda++;
+    if (hash == m_tortoise) {
+        m_info.detected = true;
+        m_info.period = m_lambda;
+        FindCycleStart(generation);
+        return true;
+    }
+    if (m_lambda == m_power) {
+        // 本轮没有追上：龟移到当前位置，下一轮步数上限翻倍
+        m_tortoise = hash;
+        m_power *= 2;
+        m_lambda = 0;
+    }
+    return false;
+}
+
+/**
+ * @brief 回溯进入周期的代数
+ *
+ * 第 s 代在周期内当且仅当它与第 s + period 代相同；从已知在周期内的 generation - period 向前找，
+ * 直到指纹不再一致，或者退到检测起点 / 历史的最早一代为止 (后者只能给出上界)。
+ */
+void CycleDetector::FindCycleStart(long long generation) {
+    const long long period = m_info.period;
+    long long oldest = generation - HISTORY_SIZE + 1;
+    if (oldest < m_firstGeneration) oldest = m_firstGeneration;
+
+    long long start = generation - period;
+    while (start > oldest && HistoryAt(start - 1) == HistoryAt(start - 1 + period)) {
+        start--;
+    }
+    m_info.startGeneration = start;
+    // 因指纹不一致而停下时精确；停在历史最早一代 (或周期比历史还长) 时，只有它正是检测起点才精确
+    m_info.startExact = start > oldest || start == m_firstGeneration;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 周期检测结果
+ */
+struct CycleInfo {
+    bool detected; ///< 是否已进入周期 (静物的周期为 1)
+    long long period; ///< 周期长度 (代)
+    long long startGeneration; ///< 进入周期的代数 (该代的棋盘与 period 代之后相同)
+    bool startExact; ///< startGeneration 是否精确；历史不够长时它只是上界
+};
+
+/**
+ * @brief 基于棋盘哈希的周期检测器 (Brent 算法)
+ *
+ * 每代输入一次棋盘哈希。Brent 算法只保存一个 "龟" 哈希：在第 1, 2, 4, 8 ... 步时把它移到当前位置，
+ * 之后当前哈希与它相等即说明进入了周期，与之相隔的步数就是周期，检测本身只需常数内存。
+ * 检测延迟不超过 进入周期的代数 + 2 x 周期 左右。
+ *
+ * 进入周期的代数需要回看：另外保存最近 HISTORY_SIZE 代哈希的 32 位指纹 (环形缓冲)，
+ * 检测到周期 p 后从当前代向前找最早的、与 p 代之后指纹一致的连续区段起点。
+ */
+class CycleDetector {
+public:
+    static constexpr int HISTORY_SIZE = 1 << 16; ///< 指纹历史的长度 (代)，必须是 2 的幂
+
+    CycleDetector();
+
+    /**
+     * @brief 从指定代重新开始检测 (棋盘被编辑、规则或拓扑改变之后)
+     * @param hash 当前棋盘哈希
+     * @param generation 当前代数
+     */
+    void Reset(uint64_t hash, long long generation);
+
+    /**
+     * @brief 清空检测状态，直到下一次 Reset 之前不再检测
+     */
+    void Clear();
+
+    /**
+     * @brief 输入下一代的棋盘哈希
+     *
+     * 代数必须与上一次输入 (或 Reset) 连续，否则从这一代重新开始。
+     * @return bool 本次输入首次检测到周期时返回 true
+     */
+    bool Observe(uint64_t hash, long long generation);
+
+    /**
+     * @brief 是否正在检测 (Reset 之后、Clear 之前)
+     */
+    bool IsActive() const { return m_active; }
+
+    const CycleInfo &GetInfo() const { return m_info; }
+
+private:
+    /**
+     * @brief 检测到周期后，在指纹历史中回溯进入周期的代数
+     */
+    void FindCycleStart(long long generation);
+
+    uint32_t &HistoryAt(long long generation) { return m_history[static_cast<size_t>(generation) & (HISTORY_SIZE - 1)]; }
+
+    bool m_active; ///< 是否正在检测
+    uint64_t m_tortoise; ///< 龟的位置上的哈希
+    long long m_power; ///< 当前轮的步数上限 (2 的幂)
+    long long m_lambda; ///< 龟之后已经走过的步数
+    long long m_firstGeneration; ///< 开始检测的代数
+    long long m_lastGeneration; ///< 最近一次输入的代数
+    std::vector<uint32_t> m_history; ///< 最近各代哈希的低 32 位 (下标为代数对 HISTORY_SIZE 取模)
+    CycleInfo m_info; ///< 检测结果
+};
@@ -36,21 +36,44 @@ bool FileManager::SaveGame(const std::wstring &filePath, const LifeGame &game) {
     fwprintf(fp, L"WIDTH=%d\n", game.GetWidth());
     fwprintf(fp, L"HEIGHT=%d\n", game.GetHeight());
     fwprintf(fp, L"SPEED=%d\n", game.GetSpeed());
+    const RuleData *rule = game.GetRuleEngine().GetRule(game.GetRuleIndex());
+    if (rule) {
+        fwprintf(fp, L"RULE=%hs\n", rule->ruleString.c_str());
+    }
 
     fwprintf(fp, L"DATA_START\n");
 
     // 3. 写入网格数据 (Grid Data)
     // 为了可读性，使用字符矩阵表示：'O' 代表活细胞，'.' 代表死细胞
     // 这种格式虽然占用空间较大，但方便人工阅读和调试
-    for (int y = 0; y < game.GetHeight(); ++y) {
-        for (int x = 0; x < game.GetWidth(); ++x) {
-            fputc(game.GetCell(x, y) ? 'O' : '.', fp);
+    // 直接按字读取位平面，先拼好整行再一次性写出
+    const BitGrid &grid = game.GetGrid();
+    std::string line(grid.GetWidth() + 1, '.');
+    line[grid.GetWidth()] = '\n';
+    for (int y = 0; y < grid.GetHeight(); ++y) {
+        const uint64_t *row = grid.GetRow(y);
+        for (int x = 0; x < grid.GetWidth(); ++x) {
+            line[x] = ((row[x >> 6] >> (x & 63)) & 1ULL) ? 'O' : '.';
         }
-        fputc('\n', fp);
+        fwrite(line.data(), 1, line.size(), fp);
     }
 
     fwprintf(fp, L"DATA_END\n");
 
+    // 4. Generations 规则的衰减态 (可选)
+    // 字符矩阵只记录活细胞，衰减中的细胞 (状态 >= 2) 按 "x y 状态" 逐个列出
+    if (game.IsGenerationsRule()) {
+        fwprintf(fp, L"STATES_START\n");
+        const StateGrid &states = game.GetStateGrid();
+        for (int y = 0; y < states.GetHeight(); ++y) {
+            const uint8_t *row = states.GetRow(y);
+            for (int x = 0; x < states.GetWidth(); ++x) {
+                if (row[x] >= 2) fwprintf(fp, L"%d %d %d\n", x, y, row[x]);
+            }
+        }
+        fwprintf(fp, L"STATES_END\n");
+    }
+
     fclose(fp);
     return true;
 }
@@ -66,7 +89,9 @@ bool FileManager::LoadGame(const std::wstring &filePath, LifeGame &game) {
     }
 
     int width = 0, height = 0, speed = 100;
+    std::string ruleString; // 旧存档没有 RULE 行，保持当前规则
     bool readingData = false;
+    bool readingStates = false;
     int currentY = 0;
 
     // 简单的行读取缓冲区
@@ -87,19 +112,46 @@ bool FileManager::LoadGame(const std::wstring &filePath, LifeGame &game) {
             readingData = true;
             // 在读取数据前，根据解析出的宽高调整网格大小
             if (width > 0 && height > 0) {
-                game.ResizeGrid(width, height);
+                if (!game.ResizeGrid(width, height)) {
+                    m_lastError = L"存档网格过大，超出内存预算";
+                    fclose(fp);
+                    return false;
+                }
                 game.ResetGrid(); // 清空当前内容
                 game.SetSpeed(speed);
             }
+            // 细胞写入之前切换规则，使 Generations 规则的状态平面与网格同步建立
+            if (!ruleString.empty()) {
+                int ruleIndex = game.FindRule(ruleString);
+                if (ruleIndex < 0) {
+                    ruleIndex = game.AddCustomRule(L"自定义 " + std::wstring(ruleString.begin(), ruleString.end()),
+                                                   ruleString);
+                }
+                if (ruleIndex >= 0) game.SetRule(ruleIndex);
+            }
             continue;
         }
 
         // 检测数据块结束标记
         if (line == L"DATA_END") {
+            readingData = false;
+            continue;
+        }
+
+        if (line == L"STATES_START") {
+            readingStates = true;
+            continue;
+        }
+        if (line == L"STATES_END") {
             break;
         }
 
-        if (readingData) {
+        if (readingStates) {
+            int x = 0, y = 0, state = 0;
+            if (swscanf_s(line.c_str(), L"%d %d %d", &x, &y, &state) == 3) {
+                game.SetCellState(x, y, state);
+            }
+        } else if (readingData) {
             // 解析网格数据行
             if (currentY < height) {
                 for (int x = 0; x < width && x < static_cast<int>(line.length()); ++x) {
@@ -119,6 +171,10 @@ bool FileManager::LoadGame(const std::wstring &filePath, LifeGame &game) {
                 if (key == L"WIDTH") width = _wtoi(val.c_str());
                 else if (key == L"HEIGHT") height = _wtoi(val.c_str());
                 else if (key == L"SPEED") speed = _wtoi(val.c_str());
+                else if (key == L"RULE") {
+                    // 规则字符串只含 ASCII 字符
+                    for (wchar_t c: val) ruleString += static_cast<char>(c);
+                }
             }
         }
     }
@@ -137,21 +193,25 @@ bool FileManager::ExportRLE(const std::wstring &filePath, const LifeGame &game)
 
     // 写入 RLE 头部
     fwprintf(fp, L"# Exported by LifeGame\n");
-    fwprintf(fp, L"x = %d, y = %d, rule = B3/S23\n", game.GetWidth(), game.GetHeight());
+    const RuleData *rule = game.GetRuleEngine().GetRule(game.GetRuleIndex());
+    fwprintf(fp, L"x = %d, y = %d, rule = %hs\n", game.GetWidth(), game.GetHeight(),
+             rule ? rule->ruleString.c_str() : "B3/S23");
 
     int runCount = 0;
     bool lastState = false; // 假设每行开始前是死细胞? 不，RLE 是连续的
     // RLE 通常逐行编码，行尾用 $
 
+    const BitGrid &grid = game.GetGrid();
     for (int y = 0; y < game.GetHeight(); ++y) {
+        const uint64_t *row = grid.GetRow(y);
         runCount = 0;
         // 获取行首第一个细胞的状态
-        bool currentState = game.GetCell(0, y);
+        bool currentState = (row[0] & 1ULL) != 0;
         runCount = 1;
 
         // 遍历该行剩余细胞
         for (int x = 1; x < game.GetWidth(); ++x) {
-            bool cell = game.GetCell(x, y);
+            bool cell = ((row[x >> 6] >> (x & 63)) & 1ULL) != 0;
             if (cell == currentState) {
                 // 如果状态相同，计数加一
                 runCount++;
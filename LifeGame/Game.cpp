@@ -1,7 +1,9 @@
 #include "Game.h"
-#include <time.h>
-#include <stdlib.h>
 #include <algorithm> // for std::min
+#include <chrono>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 /**
  * @brief 构造函数
@@ -9,15 +11,30 @@
  */
 LifeGame::LifeGame(int width, int height)
     : m_gridWidth(width), m_gridHeight(height), m_isRunning(false),
-      m_updateInterval(100), m_currentRuleIndex(0),
-      m_stats(width, height) {
-    // 限制网格大小范围，防止内存溢出或性能过低
-    // 支持大网格 (最大 2000x2000)
-    if (m_gridWidth < 4) m_gridWidth = 4;
-    if (m_gridHeight < 4) m_gridHeight = 4;
-    if (m_gridWidth > 2000) m_gridWidth = 2000;
-    if (m_gridHeight > 2000) m_gridHeight = 2000;
+      m_updateInterval(100), m_generationsPerTick(1), m_lastActiveTiles(0),
+      m_memoryBudget(DEFAULT_MEMORY_BUDGET), m_seed(0), m_currentRuleIndex(0),
+      m_compiledRule(), m_kernels(&GetActiveKernelTable()),
+      m_stepRow(nullptr), m_useRuleSpecialization(true), m_topology(BoundaryTopology::Torus),
+      m_stats(0, 0),
+      m_threadPool(ThreadPool::GetHardwareThreadCount()),
+      m_backend(SimulationBackend::Grid), m_viewX(0), m_viewY(0), m_windowDirty(true), m_generation(0),
+      m_cycleDetection(false), m_pauseOnCycle(false), m_cyclePaused(false), m_frameBirths(0), m_frameDeaths(0),
+      m_statsSink(nullptr) {
+    m_compiledRule = *m_ruleEngine.GetCompiledRule(m_currentRuleIndex);
+
+    // 限制网格大小范围：不设固定上限，只要求所需内存在预算之内 (否则退回默认尺寸)
+    if (m_gridWidth < MIN_GRID_SIZE) m_gridWidth = MIN_GRID_SIZE;
+    if (m_gridHeight < MIN_GRID_SIZE) m_gridHeight = MIN_GRID_SIZE;
+    if (m_gridWidth > MAX_GRID_SIZE || m_gridHeight > MAX_GRID_SIZE ||
+        EstimateMemoryBytes(m_gridWidth, m_gridHeight, m_compiledRule) > m_memoryBudget) {
+        m_gridWidth = 80;
+        m_gridHeight = 60;
+    }
+    m_stats.Reset(m_gridWidth, m_gridHeight);
 
+    UpdateStepKernel();
+    m_hashLife.SetRule(m_compiledRule);
+    m_sparse.SetRule(m_compiledRule);
     InitGrid();
 }
 
@@ -29,104 +46,270 @@ LifeGame::~LifeGame() {
  * 随机生成初始状态，用于演示。
  */
 void LifeGame::InitGrid() {
-    srand(static_cast<unsigned int>(time(nullptr)));
+    // 以纳秒级时钟作为新种子，每次初始化都不同，但记录下来即可复现
+    InitGrid(static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+}
+
+void LifeGame::InitGrid(uint64_t seed) {
+    m_seed = seed;
+    m_random.Seed(seed);
     // 初始化两个网格缓冲区
-    m_grid.assign(m_gridHeight, std::vector<bool>(m_gridWidth, false));
-    m_nextGrid.assign(m_gridHeight, std::vector<bool>(m_gridWidth, false));
+    m_grid.Resize(m_gridWidth, m_gridHeight);
+    m_nextGrid.Resize(m_gridWidth, m_gridHeight);
+    m_tileScheduler.Resize(m_gridWidth, m_gridHeight);
+    m_boardHash.Resize(m_tileScheduler.GetTileCount());
+    m_population.Resize(m_tileScheduler.GetTileCount());
+    m_generation = 0;
+    ClearUniverse();
 
     // 随机生成初始状态
-    // 密度约为 40% (rand() % 10 < 4)
-    for (int y = 0; y < m_gridHeight; y++) {
-        for (int x = 0; x < m_gridWidth; x++) {
-            m_grid[y][x] = (rand() % 10 < 4);
-        }
-    }
+    // 密度约为 40% (按字生成，每次抽取 64 个细胞)
+    m_grid.FillRandom(0, 0, m_gridWidth, m_gridHeight, 0.4f, m_random);
+    ResetStates();
 }
 
 /**
  * @brief 设置当前规则
  */
-void LifeGame::SetRule(int ruleIndex) {
-    if (m_ruleEngine.GetRule(ruleIndex) != nullptr) {
-        m_currentRuleIndex = ruleIndex;
+bool LifeGame::SetRule(int ruleIndex) {
+    const CompiledRule *compiled = m_ruleEngine.GetCompiledRule(ruleIndex);
+    if (compiled == nullptr) return false;
+    // Generations 的状态平面与 LtL 的前缀和表按细胞分配，大网格上可能超出预算
+    if (EstimateMemoryBytes(m_gridWidth, m_gridHeight, *compiled) > m_memoryBudget) return false;
+
+    const int oldStates = m_compiledRule.states;
+    m_currentRuleIndex = ruleIndex;
+    // 缓存一份预编译规则：演化内核直接使用，不再经过规则索引与集合查找
+    m_compiledRule = *compiled;
+    // 状态数变化时原有的衰减态不再有意义，从当前活细胞重新开始
+    if (m_compiledRule.states != oldStates) {
+        ResetStates();
     }
+    UpdateStepKernel();
+    // 新规则下原本稳定的区域也可能变化，之前的周期也不再成立
+    m_tileScheduler.MarkAllDirty();
+    m_boardHash.Invalidate();
+    // 无边界平面只支持不含 B0 的两态 3x3 全和规则，其余规则退回网格后端
+    const bool unbounded = m_hashLife.SetRule(m_compiledRule) && m_sparse.SetRule(m_compiledRule);
+    if (!unbounded) {
+        m_backend = SimulationBackend::Grid;
+    }
+    return true;
+}
+
+/**
+ * @brief 添加自定义规则
+ */
+int LifeGame::AddCustomRule(const std::wstring &name, const std::string &ruleString) {
+    return m_ruleEngine.AddCustomRule(name, ruleString);
 }
 
 /**
  * @brief 更新网格状态
- * 核心演化算法。
+ * 推进一代并记录统计数据。
  */
 void LifeGame::UpdateGrid() {
-    for (int y = 0; y < m_gridHeight; y++) {
-        for (int x = 0; x < m_gridWidth; x++) {
-            // 1. 计算邻居数量
-            int neighbors = CountNeighbors(x, y);
-            bool currentState = m_grid[y][x];
-
-            // 2. 委托给规则引擎计算下一状态
-            // 不同的规则（如 Conway, HighLife）会有不同的判定逻辑
-            bool nextState = m_ruleEngine.CalculateNextState(currentState, neighbors, m_currentRuleIndex);
-
-            // 3. 写入下一代缓冲区
-            m_nextGrid[y][x] = nextState;
-        }
+    AdvanceGeneration();
+    RecordStatistics();
+}
+
+/**
+ * @brief 推进一代
+ * 核心演化算法。
+ */
+long long LifeGame::AdvanceGeneration() {
+    if (m_backend != SimulationBackend::Grid) {
+        const long long advanced = StepUnbounded();
+        m_generation += advanced;
+        return advanced;
+    }
+
+    // 周期检测：棋盘被直接修改过 (哈希失效) 时先整体重建哈希，从当前代重新开始检测
+    // 之后各分块任务在写完结果后顺便计算变化分块的新哈希，一代结束时只合并这些分块
+    // 逐代统计输出的记录里也带有哈希
+    const bool hashing = m_cycleDetection || m_statsSink != nullptr;
+    const StateGrid *hashStates = m_compiledRule.IsGenerations() ? &m_nextStates : nullptr;
+    if (hashing && !m_boardHash.IsValid()) {
+        m_boardHash.Rebuild(m_threadPool, m_grid, m_compiledRule.IsGenerations() ? &m_states : nullptr,
+                            m_tileScheduler.GetTiles());
+        if (m_cycleDetection) m_stats.ResetCycleDetection(m_boardHash.GetValue(), m_generation);
+    }
+    auto stageHash = [&](const Tile &tile, bool changed) {
+        if (changed && hashing) m_boardHash.StageTile(tile, BoardHash::HashTile(m_nextGrid, hashStates, tile));
+        return changed;
+    };
+
+    // 人口计数：各分块在比较前后两代的同一遍里 popcount 出人口与出生/死亡数，一代结束时只合并变化的分块
+    if (!m_population.IsValid()) {
+        m_population.Rebuild(m_threadPool, m_grid, m_tileScheduler.GetTiles());
+    }
+
+    // 1-3. 位并行内核：每个字同时计算 64 个细胞的邻居数与下一状态
+    // 内置规则使用编译期特化的行内核，自定义 B/S 规则使用读取转移掩码的通用内核
+    // 网格切成分块，由工作窃取调度器并行计算 (上一代最耗时的分块最先开始)：
+    // 各分块只读前缓冲、只写自己负责的后缓冲区域，分块边界的邻居直接从前缓冲读取，
+    // 不需要同步，结果与串行路径逐位一致
+    // 自身与相邻分块上一代都没有变化的分块直接跳过 (前后缓冲中已经相同)
+    // 边界按拓扑先刷新一圈幽灵细胞，内核里不再有取模或边界判断
+    if (m_compiledRule.IsLargerThanLife()) {
+        // Larger than Life：每代先构建一次前缀和表，分块内每个细胞的计数代价与半径无关
+        // 半径可能超过相邻分块的范围 (末尾的窄分块)，3x3 膨胀不再成立，所以每代计算全部分块
+        m_ltlKernel.Prepare(m_topology, m_grid, m_compiledRule);
+        m_tileScheduler.MarkAllDirty();
+        m_tileScheduler.Run(m_threadPool, [&](const Tile &tile) {
+            return stageHash(tile, m_ltlKernel.StepTile(*m_kernels, m_grid, m_nextGrid, m_states, m_nextStates,
+                                                        tile.firstRow, tile.lastRow, tile.firstWord, tile.lastWord,
+                                                        m_compiledRule, m_population.GetStage(tile)));
+        });
+        if (m_compiledRule.IsGenerations()) m_states.Swap(m_nextStates);
+    } else if (m_compiledRule.IsGenerations()) {
+        m_halo.Refresh(m_topology, m_grid);
+        // Generations 规则：位平面照常计算出生/存活，再逐字节推进衰减态
+        // 衰减中的细胞每代都在变化，所在分块不会被跳过
+        m_tileScheduler.Run(m_threadPool, [&](const Tile &tile) {
+            return stageHash(tile, StepGenerationsTile(*m_kernels, m_stepRow, m_grid, m_nextGrid, m_states,
+                                                       m_nextStates, tile.firstRow, tile.lastRow, tile.firstWord,
+                                                       tile.lastWord, m_halo, m_compiledRule,
+                                                       m_population.GetStage(tile)));
+        });
+        m_states.Swap(m_nextStates);
+    } else {
+        m_halo.Refresh(m_topology, m_grid);
+        m_tileScheduler.Run(m_threadPool, [&](const Tile &tile) {
+            return stageHash(tile, StepGridTile(*m_kernels, m_stepRow, m_grid, m_nextGrid, tile.firstRow,
+                                                tile.lastRow, tile.firstWord, tile.lastWord, m_halo, m_compiledRule,
+                                                m_population.GetStage(tile)));
+        });
     }
 
     // 4. 交换缓冲区 (Swap Buffers)
-    // 直接赋值 vector 会触发移动语义 (Move Semantics)，效率很高，避免了深拷贝
-    m_grid = m_nextGrid;
+    // 只交换两个位平面的指针，O(1)，不发生任何拷贝或分配
+    m_grid.Swap(m_nextGrid);
+    m_lastActiveTiles = m_tileScheduler.GetActiveTileCount();
+    m_generation++;
+    m_population.Commit(m_tileScheduler);
+    m_frameBirths += m_population.GetBirths();
+    m_frameDeaths += m_population.GetDeaths();
+
+    // 5. 合并变化分块的哈希，交给周期检测器
+    if (hashing) {
+        m_boardHash.Commit(m_tileScheduler);
+        if (m_cycleDetection && m_stats.RecordBoardHash(m_boardHash.GetValue(), m_generation) && m_pauseOnCycle) {
+            m_isRunning = false;
+            m_cyclePaused = true;
+        }
+    }
 
-    // 5. 记录统计数据 (用于图表显示)
-    m_stats.RecordFrame(GetPopulation(), m_grid);
+    // 6. 逐代统计输出：只把记录放进 sink 的环形缓冲，写盘在后台线程进行
+    if (m_statsSink != nullptr) {
+        GenerationRecord record;
+        record.generation = m_generation;
+        record.population = m_population.GetPopulation();
+        record.births = m_population.GetBirths();
+        record.deaths = m_population.GetDeaths();
+        m_population.GetBoundingBox(m_grid, m_tileScheduler.GetTiles(), record.minX, record.minY, record.maxX,
+                                    record.maxY);
+        record.hash = m_boardHash.GetValue();
+        m_statsSink->Push(record);
+    }
+    return 1;
 }
 
 /**
- * @brief 获取活细胞总数
+ * @brief 推进多代 (不记录统计)
  */
-int LifeGame::GetPopulation() const {
-    int count = 0;
-    for (const auto &row: m_grid) {
-        for (bool cell: row) {
-            if (cell) count++;
-        }
+long long LifeGame::AdvanceGenerations(int generations) {
+    if (generations > 1 && m_backend == SimulationBackend::Grid && !m_cycleDetection && m_statsSink == nullptr &&
+        TemporalBlocker::IsSupported(m_topology, m_compiledRule)) {
+        // 时间分块：条带连同 Halo 读入本地缓冲后连续推进多代，只在每轮结束时写回一次
+        // 幽灵细胞由条带内部按拓扑给出，不经过 m_halo 与分块调度器
+        // 中间各代不落到整个网格上，出生/死亡数由分块器在条带内逐代统计
+        CellCounts counts;
+        m_temporalBlocker.Run(*m_kernels, m_threadPool, m_stepRow, m_topology, m_grid, m_nextGrid, generations,
+                              m_compiledRule, &counts);
+        m_frameBirths += counts.births;
+        m_frameDeaths += counts.deaths;
+        // 前后缓冲不再满足 "未变化分块内容相同" 的假设，下一次逐代演化必须全部重新计算
+        m_tileScheduler.MarkAllDirty();
+        m_lastActiveTiles = m_tileScheduler.GetTileCount();
+        m_boardHash.Invalidate();
+        m_population.Invalidate();
+        m_generation += generations;
+        return generations;
     }
-    return count;
+
+    long long advanced = 0;
+    for (int i = 0; i < generations && !m_cyclePaused; ++i) {
+        advanced += AdvanceGeneration();
+    }
+    return advanced;
 }
 
 /**
- * @brief 计算邻居数量
- * 实现了环绕世界 (Toroidal) 逻辑。
+ * @brief 连续推进多代
+ *
+ * 按采样间隔分段推进，每段结束时记录一次统计；出生/死亡数取自各段的逐代计数，不再另外比较棋盘。
  */
-int LifeGame::CountNeighbors(int x, int y) {
-    int count = 0;
-    // 优化：展开循环可以减少分支预测失败，但这里为了可读性保持循环
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            if (dx == 0 && dy == 0) continue; // 跳过自己
-
-            // 环绕处理：左边出界从右边回来，上边出界从下边回来
-            // 使用取模运算实现坐标循环
-            int nx = (x + dx + m_gridWidth) % m_gridWidth;
-            int ny = (y + dy + m_gridHeight) % m_gridHeight;
+StepSummary LifeGame::Step(int generations, const StepOptions &options) {
+    const auto start = std::chrono::steady_clock::now();
+    StepSummary summary = {};
+    if (generations < 1) {
+        summary.population = GetPopulation();
+        return summary;
+    }
 
-            if (m_grid[ny][nx]) count++;
-        }
+    m_cyclePaused = false;
+    const int interval = options.statsInterval > 0 ? options.statsInterval : generations;
+    for (int done = 0; done < generations && !m_cyclePaused;) {
+        const int chunk = std::min(interval, generations - done);
+        summary.generations += AdvanceGenerations(chunk);
+        summary.births += m_frameBirths;
+        summary.deaths += m_frameDeaths;
+        summary.population = RecordStatistics();
+        done += chunk;
     }
-    return count;
+
+    const auto end = std::chrono::steady_clock::now();
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    return summary;
+}
+
+/**
+ * @brief 记录一帧统计数据 (用于图表显示)
+ */
+long long LifeGame::RecordStatistics() {
+    const long long population = GetPopulation();
+    m_stats.RecordActiveTiles(m_lastActiveTiles, m_tileScheduler.GetTileCount());
+    m_stats.RecordFrame(population, m_frameBirths, m_frameDeaths, m_grid);
+    m_frameBirths = 0;
+    m_frameDeaths = 0;
+    return population;
+}
+
+/**
+ * @brief 获取活细胞总数
+ *
+ * 逐代演化时由分块内核增量维护，直接返回；棋盘被编辑过或由其他路径整体改写后才重新扫描。
+ */
+long long LifeGame::GetPopulation() const {
+    if (m_population.IsValid()) return m_population.GetPopulation();
+    // 按字 popcount，SIMD 路径一次处理 128/256 个细胞
+    return m_grid.CountPopulation(*m_kernels);
 }
 
 /**
  * @brief 重置网格
  */
 void LifeGame::ResetGrid() {
-    // 清空当前网格
-    for (auto &row: m_grid) {
-        std::fill(row.begin(), row.end(), false);
-    }
-    // 清空下一代缓冲区
-    for (auto &row: m_nextGrid) {
-        std::fill(row.begin(), row.end(), false);
-    }
+    // 清空当前网格与下一代缓冲区
+    m_grid.Clear();
+    m_nextGrid.Clear();
+    m_states.Clear();
+    m_nextStates.Clear();
+    m_tileScheduler.MarkAllDirty();
+    m_generation = 0;
+    // 清空整个平面，而不只是棋盘窗口
+    ClearUniverse();
     // 重置统计数据
     m_stats.Reset(m_gridWidth, m_gridHeight);
 }
@@ -135,72 +318,367 @@ void LifeGame::ResetGrid() {
  * @brief 反转网格状态
  */
 void LifeGame::InvertGrid() {
-    for (int y = 0; y < m_gridHeight; ++y) {
-        for (int x = 0; x < m_gridWidth; ++x) {
-            m_grid[y][x] = !m_grid[y][x];
-        }
-    }
+    m_grid.Invert(*m_kernels);
+    SyncStates(0, 0, m_gridWidth, m_gridHeight);
+    m_tileScheduler.MarkAllDirty();
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
 }
 
 /**
  * @brief 清空指定区域
  */
 void LifeGame::ClearArea(int x, int y, int w, int h) {
-    for (int dy = 0; dy < h; ++dy) {
-        for (int dx = 0; dx < w; ++dx) {
-            SetCell(x + dx, y + dy, false);
-        }
-    }
+    // 按字清零，区域自动裁剪到网格范围
+    m_grid.FillRect(x, y, w, h, false);
+    SyncStates(x, y, w, h);
+    m_tileScheduler.MarkDirty(x, y, w, h);
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
 }
 
 /**
  * @brief 随机填充指定区域
  */
 void LifeGame::RandomizeArea(int x, int y, int w, int h, float density) {
-    for (int dy = 0; dy < h; ++dy) {
-        for (int dx = 0; dx < w; ++dx) {
-            bool alive = (rand() % 100) < (density * 100);
-            SetCell(x + dx, y + dy, alive);
-        }
-    }
+    m_grid.FillRandom(x, y, w, h, density, m_random);
+    SyncStates(x, y, w, h);
+    m_tileScheduler.MarkDirty(x, y, w, h);
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
 }
 
+static_assert(std::is_nothrow_move_assignable<TileScheduler>::value &&
+                  std::is_nothrow_move_assignable<BoardHash>::value &&
+                  std::is_nothrow_move_assignable<PopulationCounter>::value,
+              "ResizeGrid 在提交点之后用移动赋值换入新结构，这些移动不能抛出异常");
+
 /**
  * @brief 调整网格大小
  */
-void LifeGame::ResizeGrid(int newWidth, int newHeight) {
-    if (newWidth < 4) newWidth = 4;
-    if (newHeight < 4) newHeight = 4;
-    if (newWidth > 2000) newWidth = 2000;
-    if (newHeight > 2000) newHeight = 2000;
-
-    if (newWidth == m_gridWidth && newHeight == m_gridHeight) return;
-
-    std::vector<std::vector<bool> > newGrid(newHeight, std::vector<bool>(newWidth, false));
-    std::vector<std::vector<bool> > newNext(newHeight, std::vector<bool>(newWidth, false));
+bool LifeGame::ResizeGrid(int newWidth, int newHeight) {
+    if (newWidth < MIN_GRID_SIZE) newWidth = MIN_GRID_SIZE;
+    if (newHeight < MIN_GRID_SIZE) newHeight = MIN_GRID_SIZE;
+
+    if (newWidth == m_gridWidth && newHeight == m_gridHeight) return true;
+    if (newWidth > MAX_GRID_SIZE || newHeight > MAX_GRID_SIZE ||
+        EstimateMemoryBytes(newWidth, newHeight, m_compiledRule) > m_memoryBudget) {
+        return false;
+    }
 
     // 调整大小时清空画布，不保留原有内容
+    // 与尺寸有关的结构全部先分配到临时对象中，统计数据的重置 (本身满足强异常保证) 放在最后；
+    // 任何一步分配失败时旧状态原样保留，之后的交换与移动都不会抛出异常
+    BitGrid grid, nextGrid;
+    StateGrid states, nextStates;
+    TileScheduler tileScheduler;
+    BoardHash boardHash;
+    PopulationCounter population;
+    try {
+        grid.Resize(newWidth, newHeight);
+        nextGrid.Resize(newWidth, newHeight);
+        if (m_compiledRule.IsGenerations()) {
+            states.Resize(newWidth, newHeight);
+            nextStates.Resize(newWidth, newHeight);
+        }
+        tileScheduler.SetTopology(m_topology);
+        tileScheduler.Resize(newWidth, newHeight);
+        boardHash.Resize(tileScheduler.GetTileCount());
+        population.Resize(tileScheduler.GetTileCount());
+        m_stats.Reset(newWidth, newHeight);
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+
+    // 提交点：以下步骤不抛出异常
+    m_grid.Swap(grid);
+    m_nextGrid.Swap(nextGrid);
+    m_states.Swap(states);
+    m_nextStates.Swap(nextStates);
+    m_tileScheduler = std::move(tileScheduler);
+    m_boardHash = std::move(boardHash);
+    m_population = std::move(population);
     m_gridWidth = newWidth;
     m_gridHeight = newHeight;
-    m_grid = std::move(newGrid);
-    m_nextGrid = std::move(newNext);
+    m_generation = 0;
+    ClearUniverse(); // HashLife 的空节点在构造时已缓存，清空不分配内存
+    return true;
+}
 
-    m_stats.Reset(newWidth, newHeight);
+/**
+ * @brief 估算网格占用的内存
+ *
+ * 统计热力图与视图层拖尾都是每个细胞一份，大网格上远超位平面本身，必须一起计入。
+ */
+unsigned long long LifeGame::EstimateMemoryBytes(int width, int height, const CompiledRule &rule) {
+    const unsigned long long cells = static_cast<unsigned long long>(width) * height;
+    unsigned long long bytes = BIT_PLANE_COPIES * BitGrid::BytesFor(width, height);
+    bytes += cells * Statistics::BYTES_PER_CELL;
+    bytes += cells * VIEW_BYTES_PER_CELL;
+    if (rule.IsGenerations()) bytes += 2 * cells; // 前后两个字节状态平面
+    if (rule.IsLargerThanLife()) bytes += LtlKernel::EstimateBytes(width, height, rule.ltl);
+    return bytes;
 }
 
-void LifeGame::SetCell(int x, int y, bool state) {
+void LifeGame::SetCell(int64_t x, int64_t y, bool state) {
     if (x >= 0 && x < m_gridWidth && y >= 0 && y < m_gridHeight) {
-        m_grid[y][x] = state;
+        m_grid.Set(static_cast<int>(x), static_cast<int>(y), state);
+        if (m_compiledRule.IsGenerations()) {
+            m_states.Set(static_cast<int>(x), static_cast<int>(y), state ? 1 : 0);
+        }
+        // 直接修改前缓冲，所在分块下一代必须重新计算
+        m_tileScheduler.MarkCellDirty(static_cast<int>(x), static_cast<int>(y));
+        m_boardHash.Invalidate();
+        m_population.Invalidate();
+        m_windowDirty = true;
+    } else if (m_backend == SimulationBackend::HashLife) {
+        // 棋盘外的细胞直接写入平面
+        m_hashLife.SetCell(m_viewX + x, m_viewY + y, state);
+    } else if (m_backend == SimulationBackend::Sparse) {
+        m_sparse.SetCell(m_viewX + x, m_viewY + y, state);
     }
 }
 
-bool LifeGame::GetCell(int x, int y) const {
+bool LifeGame::GetCell(int64_t x, int64_t y) const {
     if (x >= 0 && x < m_gridWidth && y >= 0 && y < m_gridHeight) {
-        return m_grid[y][x];
+        return m_grid.Get(static_cast<int>(x), static_cast<int>(y));
     }
+    if (m_backend == SimulationBackend::HashLife) return m_hashLife.GetCell(m_viewX + x, m_viewY + y);
+    if (m_backend == SimulationBackend::Sparse) return m_sparse.GetCell(m_viewX + x, m_viewY + y);
     return false;
 }
 
+int LifeGame::GetCellState(int x, int y) const {
+    if (x < 0 || x >= m_gridWidth || y < 0 || y >= m_gridHeight) return 0;
+    if (m_compiledRule.IsGenerations()) return m_states.Get(x, y);
+    return m_grid.Get(x, y) ? 1 : 0;
+}
+
+void LifeGame::SetCellState(int x, int y, int state) {
+    if (x < 0 || x >= m_gridWidth || y < 0 || y >= m_gridHeight) return;
+    if (!m_compiledRule.IsGenerations()) {
+        SetCell(x, y, state != 0);
+        return;
+    }
+    if (state < 0) state = 0;
+    if (state >= m_compiledRule.states) state = m_compiledRule.states - 1;
+    m_states.Set(x, y, static_cast<uint8_t>(state));
+    m_grid.Set(x, y, state == 1);
+    m_tileScheduler.MarkCellDirty(x, y);
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
+}
+
+/**
+ * @brief 强制指定 SIMD 级别
+ */
+void LifeGame::SetSimdLevel(SimdLevel level) {
+    // 不允许超过 CPU 实际支持的级别
+    const SimdLevel supported = DetectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported)) level = supported;
+
+    const KernelTable *table = GetKernelTable(level);
+    m_kernels = table ? table : GetScalarKernelTable();
+    UpdateStepKernel();
+}
+
+void LifeGame::SetThreadCount(int threadCount) {
+    m_threadPool.SetThreadCount(threadCount);
+}
+
+void LifeGame::SetTopology(BoundaryTopology topology) {
+    if (topology == m_topology) return;
+    m_topology = topology;
+    // 边界附近的分块在新拓扑下可能不再稳定，之前的周期也不再成立
+    m_tileScheduler.SetTopology(topology);
+    m_boardHash.Invalidate();
+}
+
+void LifeGame::SetCycleDetection(bool enabled) {
+    m_cycleDetection = enabled;
+    if (!enabled) m_stats.StopCycleDetection();
+    // 关闭期间不维护哈希，重新开启后从当前棋盘重建
+    m_boardHash.Invalidate();
+}
+
+void LifeGame::SetStatisticsSink(StatisticsSink *sink) {
+    m_statsSink = sink;
+    // 周期检测关闭时哈希没有被维护，从当前棋盘重建
+    m_boardHash.Invalidate();
+}
+
+void LifeGame::SetRuleSpecialization(bool enabled) {
+    m_useRuleSpecialization = enabled;
+    UpdateStepKernel();
+}
+
+/**
+ * @brief 选择行内核
+ *
+ * 内置规则在编译期已生成特化内核 (规则逻辑被折叠为常量表达式)，
+ * 自定义规则或禁用特化时使用通用内核。
+ */
+void LifeGame::UpdateStepKernel() {
+    if (m_compiledRule.IsNonTotalistic()) {
+        // 非全和规则无法用邻居数掩码表达，使用邻域表内核 (按位并行求值邻域网络)
+        m_stepRow = m_kernels->stepRowLut;
+        return;
+    }
+    m_stepRow = m_useRuleSpecialization ? SelectStepRow(*m_kernels, m_compiledRule) : m_kernels->stepRow;
+}
+
+/**
+ * @brief 选择演化后端
+ *
+ * 切换到无边界后端时清空平面并从当前棋盘重新导入，之前留在窗口外的内容不再保留。
+ */
+bool LifeGame::SetBackend(SimulationBackend backend) {
+    if (backend == SimulationBackend::HashLife && !m_hashLife.SetRule(m_compiledRule)) return false;
+    if (backend == SimulationBackend::Sparse && !m_sparse.SetRule(m_compiledRule)) return false;
+
+    if (backend != m_backend) {
+        ClearUniverse();
+    }
+    m_backend = backend;
+    return true;
+}
+
+/**
+ * @brief 移动棋盘窗口
+ *
+ * 先把棋盘上未同步的编辑写回平面，再从新位置取出窗口内容。网格后端下只记录原点。
+ */
+void LifeGame::SetViewOrigin(int64_t x, int64_t y) {
+    if (x == m_viewX && y == m_viewY) return;
+    if (m_backend == SimulationBackend::Grid) {
+        m_viewX = x;
+        m_viewY = y;
+        return;
+    }
+
+    SyncWindow();
+    m_viewX = x;
+    m_viewY = y;
+    if (m_backend == SimulationBackend::HashLife) {
+        m_hashLife.ExportRegion(m_viewX, m_viewY, m_grid);
+    } else {
+        m_sparse.ExportRegion(m_viewX, m_viewY, m_grid);
+    }
+    m_tileScheduler.MarkAllDirty();
+    m_population.Invalidate();
+}
+
+void LifeGame::ClearUniverse() {
+    m_hashLife.Clear();
+    m_sparse.Clear();
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
+}
+
+/**
+ * @brief 把棋盘上的编辑写回当前后端的平面
+ *
+ * 用棋盘内容替换平面上的对应窗口，窗口外的内容保留。
+ */
+void LifeGame::SyncWindow() {
+    if (!m_windowDirty) return;
+    if (m_backend == SimulationBackend::HashLife) {
+        m_hashLife.ImportRegion(m_viewX, m_viewY, m_grid);
+    } else if (m_backend == SimulationBackend::Sparse) {
+        m_sparse.ImportRegion(m_viewX, m_viewY, m_grid);
+    }
+    m_windowDirty = false;
+}
+
+/**
+ * @brief 在无边界后端上演化，再把窗口内容取回棋盘
+ */
+long long LifeGame::StepUnbounded() {
+    SyncWindow();
+    long long advanced = 1;
+    if (m_backend == SimulationBackend::HashLife) {
+        m_hashLife.Step();
+        m_hashLife.ExportRegion(m_viewX, m_viewY, m_nextGrid);
+        advanced = 1LL << m_hashLife.GetStepLog();
+    } else {
+        m_sparse.Step();
+        m_sparse.ExportRegion(m_viewX, m_viewY, m_nextGrid);
+    }
+
+    // 窗口取回到后缓冲，与当前窗口比较得到窗口内的出生/死亡数 (HashLife 一次推进多代，只比较首尾)
+    long long births = 0;
+    long long deaths = 0;
+    m_nextGrid.CountChanges(m_grid, births, deaths);
+    m_grid.Swap(m_nextGrid);
+    m_frameBirths += births;
+    m_frameDeaths += deaths;
+
+    // 网格被整体改写，切回网格后端时所有分块都要重新计算
+    // 棋盘只是平面上的一个窗口，窗口内重复不代表整个平面进入周期，因此不做周期检测
+    m_tileScheduler.MarkAllDirty();
+    m_lastActiveTiles = 0;
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_stats.StopCycleDetection();
+
+    // 逐代统计输出：每次推进提交一条窗口内的记录 (HashLife 一次推进多代，代数按实际推进的代数累计)
+    // 窗口被整体改写，人口与哈希按分块重新统计；哈希随即作废，切回网格后端时由周期检测从当前代重新开始
+    if (m_statsSink != nullptr) {
+        m_population.Rebuild(m_threadPool, m_grid, m_tileScheduler.GetTiles());
+        m_boardHash.Rebuild(m_threadPool, m_grid, nullptr, m_tileScheduler.GetTiles());
+        GenerationRecord record;
+        record.generation = m_generation + advanced;
+        record.population = m_population.GetPopulation();
+        record.births = births;
+        record.deaths = deaths;
+        m_population.GetBoundingBox(m_grid, m_tileScheduler.GetTiles(), record.minX, record.minY, record.maxX,
+                                    record.maxY);
+        record.hash = m_boardHash.GetValue();
+        m_boardHash.Invalidate();
+        m_statsSink->Push(record);
+    }
+    return advanced;
+}
+
+/**
+ * @brief 重建状态平面
+ *
+ * 两态规则下释放状态平面，不占用内存。
+ */
+void LifeGame::ResetStates() {
+    if (!m_compiledRule.IsGenerations()) {
+        m_states.Resize(0, 0);
+        m_nextStates.Resize(0, 0);
+        return;
+    }
+    m_states.Resize(m_gridWidth, m_gridHeight);
+    m_nextStates.Resize(m_gridWidth, m_gridHeight);
+    m_states.SyncFromBits(m_grid, 0, 0, m_gridWidth, m_gridHeight);
+    // 后缓冲的内容不再与前缓冲一致，所有分块都要重新计算
+    m_tileScheduler.MarkAllDirty();
+    m_boardHash.Invalidate();
+}
+
+void LifeGame::SyncStates(int x, int y, int w, int h) {
+    if (m_compiledRule.IsGenerations()) {
+        m_states.SyncFromBits(m_grid, x, y, w, h);
+    }
+}
+
+void LifeGame::PasteRegion(int x, int y, const BitGrid &region) {
+    m_grid.PasteRegion(x, y, region);
+    SyncStates(x, y, region.GetWidth(), region.GetHeight());
+    m_tileScheduler.MarkDirty(x, y, region.GetWidth(), region.GetHeight());
+    m_boardHash.Invalidate();
+    m_population.Invalidate();
+    m_windowDirty = true;
+}
+
 void LifeGame::Start() { m_isRunning = true; }
 void LifeGame::Pause() { m_isRunning = false; }
 void LifeGame::ToggleRunning() { m_isRunning = !m_isRunning; }
@@ -213,11 +691,14 @@ void LifeGame::SetSpeed(int interval) {
 }
 
 void LifeGame::IncreaseSpeed() {
+    // 定时器间隔不能再小时，改为每帧推进更多代 (统计与重绘仍然每帧一次)
     if (m_updateInterval > MIN_INTERVAL) m_updateInterval -= SPEED_STEP;
+    else if (m_generationsPerTick < MAX_GENERATIONS_PER_TICK) m_generationsPerTick *= 2;
 }
 
 void LifeGame::DecreaseSpeed() {
-    if (m_updateInterval < MAX_INTERVAL) m_updateInterval += SPEED_STEP;
+    if (m_generationsPerTick > 1) m_generationsPerTick /= 2;
+    else if (m_updateInterval < MAX_INTERVAL) m_updateInterval += SPEED_STEP;
 }
 
 /**
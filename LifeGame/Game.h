@@ -1,10 +1,57 @@
 #pragma once
 
 #include <vector>
+#include "BitGrid.h"
+#include "Xoshiro256.h"
+#include "StateGrid.h"
+#include "SimdKernel.h"
 #include "RuleEngine.h"
 #include "PatternLibrary.h"
 #include "Statistics.h"
 #include "CommandHistory.h"
+#include "ThreadPool.h"
+#include "TileScheduler.h"
+#include "LtlKernel.h"
+#include "TemporalBlocker.h"
+#include "BoardHash.h"
+#include "PopulationCounter.h"
+#include "StatisticsSink.h"
+#include "HashLife.h"
+#include "SparseUniverse.h"
+
+/**
+ * @brief 演化后端
+ */
+enum class SimulationBackend {
+    Grid, ///< 位平面网格 (环面，逐代计算)
+    HashLife, ///< HashLife 四叉树 (无边界平面，每次推进 2^k 代)
+    Sparse ///< 稀疏分块哈希表 (无边界平面，逐代计算，内存与活区域成正比)
+};
+
+/**
+ * @brief Step 的选项
+ */
+struct StepOptions {
+    /**
+     * @brief 统计采样间隔 (代)
+     *
+     * 1 = 每代记录一次 (与 UpdateGrid 相同)，k = 每 k 代记录一次，0 = 只在最后记录一次。
+     * 每次记录都要扫描整个网格 (种群数与热力图)，间隔越大，批量演化越快；
+     * 两次记录之间的多代还可以使用时间分块。
+     */
+    int statsInterval = 0;
+};
+
+/**
+ * @brief Step 的结果摘要
+ */
+struct StepSummary {
+    long long generations; ///< 实际推进的代数 (HashLife 后端为调用次数 x 2^stepLog)
+    long long population; ///< 结束时棋盘上的活细胞数
+    long long births; ///< 各代出生数之和
+    long long deaths; ///< 各代死亡数之和
+    double elapsedMs; ///< 耗时 (毫秒，含统计)
+};
 
 /**
  * @brief 游戏核心逻辑类 (Game Model)
@@ -20,10 +67,19 @@
  */
 class LifeGame {
 public:
+    static constexpr int MIN_GRID_SIZE = 4; ///< 网格最小边长
+    static constexpr int MAX_GRID_SIZE = 1 << 20; ///< 网格最大边长 (坐标以 int 表示，实际大小由内存预算决定)
+    static constexpr int BIT_PLANE_COPIES = 4; ///< 每个网格同时存在的位平面份数 (见 EstimateMemoryBytes)
+    static constexpr unsigned long long VIEW_BYTES_PER_CELL = 1; ///< 视图层每个细胞的开销 (Renderer 的拖尾亮度)
+    /// 默认内存预算：64 位程序 2 GB，32 位程序 512 MB
+    static constexpr unsigned long long DEFAULT_MEMORY_BUDGET =
+        sizeof(void *) >= 8 ? (2ULL << 30) : (512ULL << 20);
+
     /**
      * @brief 构造函数
      * 
      * 初始化游戏实例，设置默认网格大小。
+     * 尺寸超出默认内存预算时退回默认的 80 x 60。
      * @param width 初始网格宽度 (默认 80)
      * @param height 初始网格高度 (默认 60)
      */
@@ -42,19 +98,87 @@ public:
      * @brief 随机初始化网格
      * 
      * 使用随机数生成器填充网格，通常用于演示或测试。
-     * 默认密度约为 40%。
+     * 默认密度约为 40%。每次调用取一个新的种子 (由时钟生成)，可通过 GetSeed 得到以便复现。
      */
     void InitGrid();
 
+    /**
+     * @brief 用指定种子随机初始化网格
+     *
+     * 同一种子与网格尺寸总是得到相同的初始状态；之后的 RandomizeArea 也从这个种子继续抽取。
+     * @param seed 随机数种子
+     */
+    void InitGrid(uint64_t seed);
+
+    /**
+     * @brief 获取最近一次初始化使用的随机数种子
+     */
+    uint64_t GetSeed() const { return m_seed; }
+
     /**
      * @brief 计算下一代状态
      * 
-     * 这是游戏的核心循环函数。它遍历所有细胞，
-     * 计算邻居数量，并根据当前规则更新状态。
-     * 采用双缓冲技术，计算结果存入 m_nextGrid，最后交换。
+     * 这是游戏的核心循环函数。使用位并行 (SWAR) 内核一次计算 64 个细胞：
+     * 用全加器逻辑统计邻居数，再把当前 B/S 规则作为和位的布尔函数求值。
+     * 具体使用 标量 / SSE2 / AVX2 中的哪一种实现，由启动时的 CPU 检测决定。
+     * 采用双缓冲技术，计算结果存入 m_nextGrid，最后以 O(1) 代价交换两个缓冲区。
      */
     void UpdateGrid();
 
+    /**
+     * @brief 连续推进 generations 代 (网格后端；HashLife 后端为 generations 次 2^stepLog 代)
+     *
+     * 统计数据按 options.statsInterval 采样，未采样的各代不做种群统计与热力图扫描。
+     * 两次采样之间超过 1 代且当前规则/拓扑支持时 (见 TemporalBlocker::IsSupported) 使用时间分块：
+     * 每个条带读入一次就连续推进多代，网格放不进缓存时大幅减少访存量。
+     * @param generations 推进的代数 (小于 1 时不演化，只返回当前种群数)
+     * @param options 统计采样方式 (默认只在最后记录一次)
+     * @return StepSummary 代数、种群数、累计出生/死亡数与耗时
+     */
+    StepSummary Step(int generations, const StepOptions &options = StepOptions());
+
+    /**
+     * @brief 设置时间分块每轮推进的代数 (见 TemporalBlocker::SetDepth)
+     */
+    void SetTemporalBlockDepth(int depth) { m_temporalBlocker.SetDepth(depth); }
+
+    int GetTemporalBlockDepth() const { return m_temporalBlocker.GetDepth(); }
+
+    /**
+     * @brief 开启/关闭周期检测 (默认关闭，仅网格后端)
+     *
+     * 开启时每代增量更新棋盘哈希 (只重新计算变化的分块) 并交给 Statistics 中的 Brent 检测器，
+     * 结果见 GetStatistics().GetCycleInfo()。
+     * 检测需要每一代的哈希，因此开启时多代推进不使用时间分块，改为逐代分块调度；
+     * 大网格上这会明显变慢，所以默认关闭，由需要显示周期的调用方 (例如主窗口状态栏) 显式开启。
+     */
+    void SetCycleDetection(bool enabled);
+
+    bool IsCycleDetectionEnabled() const { return m_cycleDetection; }
+
+    /**
+     * @brief 检测到周期时是否自动暂停 (IsRunning 变为 false，进行中的 Step 提前结束)
+     */
+    void SetPauseOnCycle(bool enabled) { m_pauseOnCycle = enabled; }
+
+    bool GetPauseOnCycle() const { return m_pauseOnCycle; }
+
+    /**
+     * @brief 设置逐代统计的输出 (传 nullptr 取消，不接管所有权)
+     *
+     * 网格后端每推进一代提交一条记录 (代数、人口、出生/死亡、外接矩形、棋盘哈希)，由 sink 的后台线程写盘。
+     * 与周期检测一样需要每一代的结果，因此设置后多代推进不使用时间分块。
+     * 无边界后端每次推进提交一条棋盘窗口内的记录 (HashLife 一次推进 2^stepLog 代，出生/死亡只比较首尾)。
+     */
+    void SetStatisticsSink(StatisticsSink *sink);
+
+    StatisticsSink *GetStatisticsSink() const { return m_statsSink; }
+
+    /**
+     * @brief 获取自上次初始化/清空/调整尺寸以来推进的代数
+     */
+    long long GetGeneration() const { return m_generation; }
+
     /**
      * @brief 清空网格
      * 
@@ -83,7 +207,8 @@ public:
     /**
      * @brief 随机填充指定区域
      * 
-     * 在矩形区域内随机生成活细胞。
+     * 在矩形区域内随机生成活细胞，按字写入 (每次抽取生成 64 个细胞)，区域会被裁剪到棋盘范围内。
+     * 随机数取自 InitGrid 设定种子的生成器。
      * @param x 区域左上角 X 坐标
      * @param y 区域左上角 Y 坐标
      * @param w 区域宽度
@@ -97,20 +222,42 @@ public:
      * 
      * 动态调整游戏区域的大小。
      * 注意：当前实现会清空原有内容（根据用户需求）。
+     * 尺寸不再有固定上限，而是按当前规则估算所需内存 (见 EstimateMemoryBytes) 并与内存预算比较；
+     * 新缓冲区全部分配成功后才替换旧的，因此失败时网格保持原样。
      * 
-     * @param newWidth 新宽度
-     * @param newHeight 新高度
+     * @param newWidth 新宽度 (小于 MIN_GRID_SIZE 时按 MIN_GRID_SIZE 处理)
+     * @param newHeight 新高度 (同上)
+     * @return bool 超出内存预算、超过 MAX_GRID_SIZE 或内存分配失败时返回 false (网格不变)
+     */
+    bool ResizeGrid(int newWidth, int newHeight);
+
+    /**
+     * @brief 估算指定尺寸的网格在某条规则下占用的内存 (字节)
+     *
+     * 按每个细胞的实际开销累加：位平面 (前后缓冲、时间分块的本地缓冲)、
+     * 统计热力图、视图层的拖尾亮度，Generations 规则的两个状态平面，以及 LtL 规则的前缀和表。
      */
-    void ResizeGrid(int newWidth, int newHeight);
+    static unsigned long long EstimateMemoryBytes(int width, int height, const CompiledRule &rule);
+
+    /**
+     * @brief 设置内存预算 (字节)
+     *
+     * 只影响之后的 ResizeGrid / SetRule，不会缩小当前网格。
+     */
+    void SetMemoryBudget(unsigned long long bytes) { m_memoryBudget = bytes; }
+
+    unsigned long long GetMemoryBudget() const { return m_memoryBudget; }
 
     /**
      * @brief 设置单个细胞状态
      * 
+     * 坐标相对于棋盘左上角。网格后端忽略棋盘外的坐标；
+     * 无边界后端下棋盘外的坐标直接写入平面 (平面坐标 = 窗口原点 + 坐标)。
      * @param x X坐标
      * @param y Y坐标
      * @param state true为活，false为死
      */
-    void SetCell(int x, int y, bool state);
+    void SetCell(int64_t x, int64_t y, bool state);
 
     /**
      * @brief 获取单个细胞状态
@@ -118,9 +265,46 @@ public:
      * @param x X坐标
      * @param y Y坐标
      * @return true 活
-     * @return false 死 (或越界)
+     * @return false 死 (或网格后端下越界)
      */
-    bool GetCell(int x, int y) const;
+    bool GetCell(int64_t x, int64_t y) const;
+
+    /**
+     * @brief 将一块区域覆盖写入网格
+     *
+     * 用于撤销图案放置等批量恢复操作，超出网格的部分会被裁剪。
+     * @param x 区域左上角 X 坐标
+     * @param y 区域左上角 Y 坐标
+     * @param region 区域数据
+     */
+    void PasteRegion(int x, int y, const BitGrid &region);
+
+    /**
+     * @brief 获取当前代位平面网格 (只读)
+     *
+     * 供统计、渲染、文件存取等模块按字 (64 细胞) 批量读取。
+     */
+    const BitGrid &GetGrid() const { return m_grid; }
+
+    /**
+     * @brief 获取单个细胞的状态值
+     *
+     * Generations 规则下返回 0 (死)、1 (活) 或 2 .. 状态数-1 (衰减中)；
+     * 两态规则下等价于 GetCell。棋盘外返回 0。
+     */
+    int GetCellState(int x, int y) const;
+
+    /**
+     * @brief 设置单个细胞的状态值 (用于载入存档中的衰减态)
+     *
+     * 状态会被裁剪到 [0, 状态数-1]；两态规则下非 0 即为活。棋盘外的坐标被忽略。
+     */
+    void SetCellState(int x, int y, int state);
+
+    /**
+     * @brief 获取当前代的字节状态平面 (只读，仅在 Generations 规则下有效)
+     */
+    const StateGrid &GetStateGrid() const { return m_states; }
 
     // ==========================================
     // 游戏控制 (Game Control)
@@ -149,8 +333,40 @@ public:
      * @brief 设置当前演化规则
      * 
      * @param ruleIndex 规则引擎中的索引
+     * @return bool 索引无效，或新规则的额外数据 (状态平面、前缀和表) 会超出内存预算时返回 false (规则不变)
+     */
+    bool SetRule(int ruleIndex);
+
+    /**
+     * @brief 获取当前规则在规则引擎中的索引
+     */
+    int GetRuleIndex() const { return m_currentRuleIndex; }
+
+    /**
+     * @brief 获取当前规则的状态数 (两态规则为 2)
+     */
+    int GetStateCount() const { return m_compiledRule.states; }
+
+    /**
+     * @brief 当前规则是否为 Generations (多状态衰减) 规则
+     */
+    bool IsGenerationsRule() const { return m_compiledRule.IsGenerations(); }
+
+    /**
+     * @brief 添加并编译一条自定义规则
+     *
+     * @param name 规则名称
+     * @param ruleString 规则字符串 (例如 "B36/S23")
+     * @return int 新规则的索引，可传给 SetRule；规则字符串无效时返回 -1
      */
-    void SetRule(int ruleIndex);
+    int AddCustomRule(const std::wstring &name, const std::string &ruleString);
+
+    /**
+     * @brief 查找与规则字符串等价的已有规则
+     *
+     * @return int 规则索引，找不到 (或字符串无效) 时返回 -1
+     */
+    int FindRule(const std::string &ruleString) { return m_ruleEngine.FindRule(ruleString); }
 
     /**
      * @brief 获取规则引擎引用
@@ -167,6 +383,11 @@ public:
      */
     const Statistics &GetStatistics() const { return m_stats; }
 
+    /**
+     * @brief 设置统计历史窗口的长度 (帧，见 Statistics::SetHistorySize)
+     */
+    void SetStatisticsWindow(size_t frames) { m_stats.SetHistorySize(frames); }
+
     /**
      * @brief 获取命令历史记录引用 (用于撤销/重做)
      */
@@ -177,8 +398,8 @@ public:
     // ==========================================
 
     void SetSpeed(int interval); ///< 设置更新间隔(ms)
-    void IncreaseSpeed(); ///< 增加速度 (减少间隔)
-    void DecreaseSpeed(); ///< 减少速度 (增加间隔)
+    void IncreaseSpeed(); ///< 增加速度 (先减少间隔，间隔最小后每帧推进的代数翻倍)
+    void DecreaseSpeed(); ///< 减少速度 (先把每帧推进的代数减半，减到 1 后增加间隔)
 
     // ==========================================
     // 状态查询 (State Query)
@@ -188,42 +409,207 @@ public:
     int GetHeight() const { return m_gridHeight; }
     bool IsRunning() const { return m_isRunning; }
     int GetSpeed() const { return m_updateInterval; }
+    int GetGenerationsPerTick() const { return m_generationsPerTick; } ///< 自动演化时每帧推进的代数
+
+    long long GetPopulation() const; ///< 获取当前活细胞总数 (大网格可能超过 int 范围)，逐代演化后为 O(1)
+
+    long long GetLastBirths() const { return m_population.GetBirths(); } ///< 最近一代逐代演化中出生的细胞数
+    long long GetLastDeaths() const { return m_population.GetDeaths(); } ///< 最近一代逐代演化中死亡的细胞数
+
+    /**
+     * @brief 获取当前使用的 SIMD 级别
+     */
+    SimdLevel GetSimdLevel() const { return m_kernels->level; }
+
+    /**
+     * @brief 获取当前内核实现的名称 (例如 "AVX2")
+     */
+    const char *GetKernelName() const { return m_kernels->name; }
+
+    /**
+     * @brief 强制使用指定的 SIMD 级别
+     *
+     * 主要用于对比测试与排查问题。若请求的级别高于 CPU 支持的级别，则使用 CPU 支持的最高级别。
+     * @param level 期望的级别
+     */
+    void SetSimdLevel(SimdLevel level);
+
+    /**
+     * @brief 启用/禁用内置规则的特化内核
+     *
+     * 禁用后所有规则都走通用内核，用于基准测试与结果对比。默认启用。
+     * @param enabled 是否启用
+     */
+    void SetRuleSpecialization(bool enabled);
 
-    int GetPopulation() const; ///< 获取当前活细胞总数
+    /**
+     * @brief 当前规则是否正在使用特化内核
+     */
+    bool IsRuleSpecialized() const { return m_stepRow != m_kernels->stepRow && !m_compiledRule.IsNonTotalistic(); }
+
+    /**
+     * @brief 设置演化使用的线程数
+     *
+     * 网格按分块以工作窃取方式分给各线程，结果与串行计算逐位一致。
+     * 设为 1 时完全在调用线程上串行执行 (用于确定性测试与对比)。
+     * @param threadCount 线程数 (含调用线程)，小于 1 时按 1 处理
+     */
+    void SetThreadCount(int threadCount);
+
+    /**
+     * @brief 获取演化使用的线程数
+     */
+    int GetThreadCount() const { return m_threadPool.GetThreadCount(); }
+
+    /**
+     * @brief 设置网格后端的边界拓扑
+     *
+     * 拓扑只决定每代刷新幽灵细胞的方式，演化内核不变。无边界后端不受影响。
+     * @param topology 环面 / 有界平面 / 克莱因瓶 / 交叉帽
+     */
+    void SetTopology(BoundaryTopology topology);
+
+    BoundaryTopology GetTopology() const { return m_topology; }
+
+    // ==========================================
+    // 演化后端 (Simulation Backend)
+    // ==========================================
+
+    /**
+     * @brief 选择演化后端
+     *
+     * HashLife 与 Sparse 后端把棋盘当作无边界平面上的一个窗口：图案离开棋盘后继续存在于平面中，
+     * 而不是像网格后端那样从对边绕回。HashLife 每次 UpdateGrid 推进 2^stepLog 代，Sparse 推进 1 代。
+     * @param backend 后端
+     * @return bool 当前规则含 B0、为 Generations、LtL 或非全和规则时无法使用无边界后端，返回 false 且后端不变
+     */
+    bool SetBackend(SimulationBackend backend);
+
+    SimulationBackend GetBackend() const { return m_backend; }
+
+    /**
+     * @brief 设置 HashLife 后端每次 UpdateGrid 推进的代数 (2^stepLog)
+     */
+    void SetHashLifeStepLog(int stepLog) { m_hashLife.SetStepLog(stepLog); }
+
+    int GetHashLifeStepLog() const { return m_hashLife.GetStepLog(); }
+
+    /**
+     * @brief 获取 HashLife 引擎 (只读)，用于查询总代数与整个平面的种群
+     */
+    const HashLife &GetHashLife() const { return m_hashLife; }
+
+    /**
+     * @brief 获取稀疏分块宇宙 (只读)，用于查询分块数与内存占用
+     */
+    const SparseUniverse &GetSparseUniverse() const { return m_sparse; }
+
+    /**
+     * @brief 设置棋盘窗口在平面上的左上角坐标 (仅对无边界后端有意义)
+     */
+    void SetViewOrigin(int64_t x, int64_t y);
+
+    int64_t GetViewX() const { return m_viewX; }
+    int64_t GetViewY() const { return m_viewY; }
 
 private:
     /**
-     * @brief 计算邻居数量
-     * 
-     * 计算指定坐标周围8个邻居中活细胞的数量。
-     * 支持环绕世界 (Toroidal) 拓扑结构：
-     * 左边界连接右边界，上边界连接下边界。
-     * 
-     * @param x X坐标
-     * @param y Y坐标
-     * @return int 活邻居数量 (0-8)
+     * @brief 根据当前规则与指令集重新选择行内核
+     */
+    void UpdateStepKernel();
+
+    /**
+     * @brief 清空两个无边界平面，下次演化前重新导入棋盘
+     */
+    void ClearUniverse();
+
+    void SyncWindow();
+
+    /**
+     * @brief 在当前后端上推进一代 (不记录统计)
+     * @return long long 实际推进的代数
+     */
+    long long AdvanceGeneration();
+
+    /**
+     * @brief 推进 generations 代 (不记录统计)，条件允许时使用时间分块
+     * @return long long 实际推进的代数
+     */
+    long long AdvanceGenerations(int generations);
+
+    /**
+     * @brief 在无边界后端上推进一次，再把窗口内容取回棋盘
+     */
+    long long StepUnbounded();
+
+    /**
+     * @brief 记录一帧统计数据 (活跃分块、种群数与热力图)
+     * @return long long 当前种群数
+     */
+    long long RecordStatistics();
+
+    /**
+     * @brief 进入 Generations 规则或网格尺寸变化时，重建状态平面 (所有衰减态被清除)
+     */
+    void ResetStates();
+
+    /**
+     * @brief 直接编辑位平面之后，用它重写状态平面的对应区域 (仅 Generations 规则下)
      */
-    int CountNeighbors(int x, int y);
+    void SyncStates(int x, int y, int w, int h);
 
     // 数据成员
-    std::vector<std::vector<bool> > m_grid; ///< 当前代网格数据
-    std::vector<std::vector<bool> > m_nextGrid; ///< 下一代网格缓存 (双缓冲)
+    BitGrid m_grid; ///< 当前代网格数据 (前缓冲)
+    BitGrid m_nextGrid; ///< 下一代网格缓存 (后缓冲，双缓冲)
     int m_gridWidth; ///< 网格宽度
     int m_gridHeight; ///< 网格高度
+    StateGrid m_states; ///< 当前代字节状态平面 (仅 Generations 规则使用)
+    StateGrid m_nextStates; ///< 下一代字节状态平面 (与位平面一起双缓冲)
 
     // 运行状态
     bool m_isRunning; ///< 是否正在自动演化
     int m_updateInterval; ///< 帧更新间隔 (毫秒)
+    int m_generationsPerTick; ///< 自动演化时每帧推进的代数
+    int m_lastActiveTiles; ///< 最近一次演化实际计算的分块数 (统计用)
+    unsigned long long m_memoryBudget; ///< 网格相关数据允许占用的内存上限 (字节)
+    uint64_t m_seed; ///< 最近一次 InitGrid 使用的种子
+    Xoshiro256 m_random; ///< 随机填充使用的生成器 (由 m_seed 初始化)
     int m_currentRuleIndex; ///< 当前使用的规则索引
+    CompiledRule m_compiledRule; ///< 当前规则的预编译转移表 (SetRule 时缓存，内核直接使用)
+    const KernelTable *m_kernels; ///< 当前使用的 SIMD 内核函数表
+    StepRowFn m_stepRow; ///< 当前规则使用的行内核 (特化或通用)
+    bool m_useRuleSpecialization; ///< 是否允许使用内置规则的特化内核
+    BoundaryTopology m_topology; ///< 网格后端的边界拓扑
+    BoundaryHalo m_halo; ///< 当前代的幽灵细胞 (每代演化前刷新)
+    LtlKernel m_ltlKernel; ///< Larger than Life 规则的前缀和内核
+    TemporalBlocker m_temporalBlocker; ///< 多代连续推进时使用的时间分块演化器
 
     // 子系统
     RuleEngine m_ruleEngine; ///< 规则引擎实例，负责规则逻辑
     PatternLibrary m_patternLibrary; ///< 图案库实例，负责图案数据
     Statistics m_stats; ///< 统计模块实例，负责数据统计
     CommandHistory m_commandHistory; ///< 命令历史记录，负责撤销/重做
+    ThreadPool m_threadPool; ///< 常驻工作线程池
+    TileScheduler m_tileScheduler; ///< 分块调度器 (记录每个分块的耗时)
+    HashLife m_hashLife; ///< HashLife 引擎 (HashLife 后端使用)
+    SparseUniverse m_sparse; ///< 稀疏分块宇宙 (Sparse 后端使用)
+    SimulationBackend m_backend; ///< 当前演化后端
+    int64_t m_viewX; ///< 棋盘窗口左上角在平面上的 X 坐标
+    int64_t m_viewY; ///< 棋盘窗口左上角在平面上的 Y 坐标
+    bool m_windowDirty; ///< 棋盘被直接修改过，下次演化前需要写回无边界平面
+    long long m_generation; ///< 当前代数
+    BoardHash m_boardHash; ///< 增量棋盘哈希 (棋盘被直接修改后失效，下次演化前重建)
+    bool m_cycleDetection; ///< 是否开启周期检测
+    bool m_pauseOnCycle; ///< 检测到周期时是否自动暂停
+    bool m_cyclePaused; ///< 本次 Step 中因检测到周期而暂停，剩余的代数不再推进
+    PopulationCounter m_population; ///< 增量人口计数 (棋盘被直接修改后失效，下次演化前重新计数)
+    long long m_frameBirths; ///< 上次记录统计以来逐代累计的出生数
+    long long m_frameDeaths; ///< 上次记录统计以来逐代累计的死亡数
+    StatisticsSink *m_statsSink; ///< 逐代统计的输出 (不拥有，可为 nullptr)
 
     // 常量定义
     static constexpr int MIN_INTERVAL = 10; ///< 最小间隔 (最快)
     static constexpr int MAX_INTERVAL = 1000; ///< 最大间隔 (最慢)
     static constexpr int SPEED_STEP = 10; ///< 速度调节步长
+    static constexpr int MAX_GENERATIONS_PER_TICK = 4096; ///< 每帧最多推进的代数
 };
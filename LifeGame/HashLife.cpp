@@ -0,0 +1,483 @@
+#include "HashLife.h"
+#include <algorithm>
+#include "RuleEngine.h"
+
+static constexpr size_t NODE_BLOCK_SIZE = 4096; ///< 每次分配的节点个数
+static constexpr size_t INITIAL_BUCKETS = size_t(1) << 16; ///< 初始哈希桶数
+
+HashLife::HashLife()
+    : m_freeList(nullptr), m_nodeCount(0), m_maxNodes(DEFAULT_MAX_NODES), m_collectThreshold(DEFAULT_MAX_NODES),
+      m_root(nullptr),
+      m_originX(0), m_originY(0), m_generation(0), m_stepLog(0),
+      m_rule(RuleEngine::CompileRule({3}, {2, 3})) {
+    for (int i = 0; i < 2; ++i) {
+        Node &leaf = m_leaves[i];
+        leaf.nw = leaf.ne = leaf.sw = leaf.se = nullptr;
+        leaf.result = nullptr;
+        leaf.next = nullptr;
+        leaf.population = static_cast<uint64_t>(i);
+        leaf.level = 0;
+        leaf.marked = false;
+    }
+    m_buckets.assign(INITIAL_BUCKETS, nullptr);
+    m_emptyNodes.push_back(&m_leaves[0]);
+    Clear();
+}
+
+HashLife::~HashLife() {
+}
+
+/**
+ * @brief 清空宇宙
+ *
+ * 旧节点留在缓存中，由下一次垃圾回收释放。
+ */
+void HashLife::Clear() {
+    m_root = Empty(3);
+    m_originX = -4;
+    m_originY = -4;
+    m_generation = 0;
+}
+
+bool HashLife::IsRuleSupported(const CompiledRule &rule) {
+    return (rule.GetBirthMask() & 1u) == 0 && !rule.IsGenerations() && !rule.IsLargerThanLife() &&
+           !rule.IsNonTotalistic();
+}
+
+bool HashLife::SetRule(const CompiledRule &rule) {
+    if (!IsRuleSupported(rule)) return false;
+    if (rule.transitions != m_rule.transitions) {
+        m_rule = rule;
+        ClearResults();
+    }
+    return true;
+}
+
+void HashLife::SetStepLog(int stepLog) {
+    if (stepLog < 0) stepLog = 0;
+    if (stepLog > MAX_STEP_LOG) stepLog = MAX_STEP_LOG;
+    if (stepLog != m_stepLog) {
+        m_stepLog = stepLog;
+        ClearResults();
+    }
+}
+
+// ==========================================
+// 节点管理 (Node Management)
+// ==========================================
+
+HashLife::Node *HashLife::AllocNode() {
+    if (!m_freeList) {
+        std::unique_ptr<Node[]> block(new Node[NODE_BLOCK_SIZE]);
+        for (size_t i = 0; i < NODE_BLOCK_SIZE; ++i) {
+            block[i].next = m_freeList;
+            m_freeList = &block[i];
+        }
+        m_blocks.push_back(std::move(block));
+    }
+    Node *n = m_freeList;
+    m_freeList = n->next;
+    return n;
+}
+
+size_t HashLife::HashChildren(const Node *nw, const Node *ne, const Node *sw, const Node *se) {
+    uint64_t h = reinterpret_cast<uintptr_t>(nw);
+    h = h * 0x9E3779B97F4A7C15ULL + reinterpret_cast<uintptr_t>(ne);
+    h = h * 0x9E3779B97F4A7C15ULL + reinterpret_cast<uintptr_t>(sw);
+    h = h * 0x9E3779B97F4A7C15ULL + reinterpret_cast<uintptr_t>(se);
+    return static_cast<size_t>(h ^ (h >> 29));
+}
+
+/**
+ * @brief 查找或创建规范节点
+ *
+ * 四个子节点完全相同的节点只存在一份，因此节点相等等价于指针相等。
+ * m_pathRoots 非空说明正处于 Result 递归中，此时在新建节点前检查回收阈值。
+ */
+HashLife::Node *HashLife::Join(Node *nw, Node *ne, Node *sw, Node *se) {
+    const size_t index = HashChildren(nw, ne, sw, se) & (m_buckets.size() - 1);
+    for (Node *n = m_buckets[index]; n; n = n->next) {
+        if (n->nw == nw && n->ne == ne && n->sw == sw && n->se == se) return n;
+    }
+
+    // 回收只移除节点、不改变桶数，index 仍然有效；要找的节点刚才不存在，回收后也不会存在
+    if (!m_pathRoots.empty() && m_nodeCount >= m_collectThreshold) {
+        Node *children[4] = {nw, ne, sw, se};
+        m_pathRoots.insert(m_pathRoots.end(), children, children + 4);
+        CollectGarbage();
+        m_pathRoots.resize(m_pathRoots.size() - 4);
+    }
+
+    Node *n = AllocNode();
+    n->nw = nw;
+    n->ne = ne;
+    n->sw = sw;
+    n->se = se;
+    n->result = nullptr;
+    n->population = nw->population + ne->population + sw->population + se->population;
+    n->level = nw->level + 1;
+    n->marked = false;
+    n->next = m_buckets[index];
+    m_buckets[index] = n;
+
+    if (++m_nodeCount > m_buckets.size()) {
+        Rehash(m_buckets.size() * 2);
+    }
+    return n;
+}
+
+HashLife::Node *HashLife::Empty(int level) {
+    while (static_cast<int>(m_emptyNodes.size()) <= level) {
+        Node *e = m_emptyNodes.back();
+        m_emptyNodes.push_back(Join(e, e, e, e));
+    }
+    return m_emptyNodes[level];
+}
+
+void HashLife::Rehash(size_t bucketCount) {
+    std::vector<Node *> buckets(bucketCount, nullptr);
+    for (Node *head: m_buckets) {
+        while (head) {
+            Node *n = head;
+            head = head->next;
+            const size_t index = HashChildren(n->nw, n->ne, n->sw, n->se) & (bucketCount - 1);
+            n->next = buckets[index];
+            buckets[index] = n;
+        }
+    }
+    m_buckets.swap(buckets);
+}
+
+void HashLife::ClearResults() {
+    for (Node *n: m_buckets) {
+        for (; n; n = n->next) {
+            n->result = nullptr;
+        }
+    }
+}
+
+void HashLife::Mark(Node *n) {
+    if (n->level == 0 || n->marked) return;
+    n->marked = true;
+    Mark(n->nw);
+    Mark(n->ne);
+    Mark(n->sw);
+    Mark(n->se);
+}
+
+/**
+ * @brief 垃圾回收
+ *
+ * 1. 从根节点、各级空节点与递归路径上的节点出发，沿子节点标记仍在使用的节点 (不沿 RESULT 标记)；
+ * 2. 未标记的节点移出哈希表，放回空闲链表；
+ * 3. 指向已回收节点的 RESULT 缓存置空 (之后按需重新计算)；
+ * 4. 清除标记，并按存活节点数更新推进过程中的回收阈值。
+ */
+void HashLife::CollectGarbage() {
+    Mark(m_root);
+    for (Node *e: m_emptyNodes) {
+        Mark(e);
+    }
+    for (Node *n: m_pathRoots) {
+        Mark(n);
+    }
+
+    for (Node *&head: m_buckets) {
+        Node **link = &head;
+        while (*link) {
+            Node *n = *link;
+            if (n->marked) {
+                link = &n->next;
+            } else {
+                *link = n->next;
+                n->next = m_freeList;
+                m_freeList = n;
+                --m_nodeCount;
+            }
+        }
+    }
+
+    for (Node *n: m_buckets) {
+        for (; n; n = n->next) {
+            if (n->result && !n->result->marked) n->result = nullptr;
+        }
+    }
+    for (Node *n: m_buckets) {
+        for (; n; n = n->next) {
+            n->marked = false;
+        }
+    }
+    m_collectThreshold = std::max(m_maxNodes, m_nodeCount * 2);
+}
+
+// ==========================================
+// 演化 (Evolution)
+// ==========================================
+
+HashLife::Node *HashLife::Centre(Node *n) {
+    return Join(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+/**
+ * @brief 4x4 基本情形
+ *
+ * 把 16 个细胞展开为位掩码 (第 y*4+x 位)，对中心 4 个细胞逐个数邻居。
+ */
+HashLife::Node *HashLife::BaseResult(Node *n) {
+    const Node *cells[4][4] = {
+        {n->nw->nw, n->nw->ne, n->ne->nw, n->ne->ne},
+        {n->nw->sw, n->nw->se, n->ne->sw, n->ne->se},
+        {n->sw->nw, n->sw->ne, n->se->nw, n->se->ne},
+        {n->sw->sw, n->sw->se, n->se->sw, n->se->se}
+    };
+    unsigned bits = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            if (cells[y][x]->population) bits |= 1u << (y * 4 + x);
+        }
+    }
+
+    Node *next[2][2];
+    for (int y = 1; y <= 2; ++y) {
+        for (int x = 1; x <= 2; ++x) {
+            int neighbors = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (dx == 0 && dy == 0) continue;
+                    neighbors += (bits >> ((y + dy) * 4 + (x + dx))) & 1u;
+                }
+            }
+            const bool alive = ((bits >> (y * 4 + x)) & 1u) != 0;
+            next[y - 1][x - 1] = &m_leaves[m_rule.NextState(alive, neighbors) ? 1 : 0];
+        }
+    }
+    return Join(next[0][0], next[0][1], next[1][0], next[1][1]);
+}
+
+/**
+ * @brief 计算 RESULT
+ *
+ * 把 level L 的节点拆成 9 个互相重叠的 level L-1 子节点，分两轮推进：
+ * - 全速 (stepLog >= L-2)：两轮都递归取 RESULT，各推进 2^(L-3) 代，合计 2^(L-2) 代；
+ * - 限速：第一轮只取中心 (不推进)，第二轮递归推进 2^stepLog 代。
+ * 下层调用可能回收垃圾，因此每个新求出的中间节点都立即压入 m_pathRoots。
+ */
+HashLife::Node *HashLife::Result(Node *n) {
+    if (n->result) return n->result;
+
+    const size_t pathSize = m_pathRoots.size();
+    auto keep = [this](Node *p) {
+        m_pathRoots.push_back(p);
+        return p;
+    };
+    keep(n);
+
+    Node *r;
+    if (n->population == 0) {
+        r = Empty(n->level - 1);
+    } else if (n->level == 2) {
+        r = BaseResult(n);
+    } else {
+        // 四角的子节点由 n 保留，其余五个是新建的中间节点
+        Node *n00 = n->nw;
+        Node *n01 = keep(Join(n->nw->ne, n->ne->nw, n->nw->se, n->ne->sw));
+        Node *n02 = n->ne;
+        Node *n10 = keep(Join(n->nw->sw, n->nw->se, n->sw->nw, n->sw->ne));
+        Node *n11 = keep(Join(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw));
+        Node *n12 = keep(Join(n->ne->sw, n->ne->se, n->se->nw, n->se->ne));
+        Node *n20 = n->sw;
+        Node *n21 = keep(Join(n->sw->ne, n->se->nw, n->sw->se, n->se->sw));
+        Node *n22 = n->se;
+
+        Node *a00, *a01, *a02, *a10, *a11, *a12, *a20, *a21, *a22;
+        if (m_stepLog >= n->level - 2) {
+            a00 = keep(Result(n00));
+            a01 = keep(Result(n01));
+            a02 = keep(Result(n02));
+            a10 = keep(Result(n10));
+            a11 = keep(Result(n11));
+            a12 = keep(Result(n12));
+            a20 = keep(Result(n20));
+            a21 = keep(Result(n21));
+            a22 = keep(Result(n22));
+        } else {
+            a00 = keep(Centre(n00));
+            a01 = keep(Centre(n01));
+            a02 = keep(Centre(n02));
+            a10 = keep(Centre(n10));
+            a11 = keep(Centre(n11));
+            a12 = keep(Centre(n12));
+            a20 = keep(Centre(n20));
+            a21 = keep(Centre(n21));
+            a22 = keep(Centre(n22));
+        }
+
+        Node *r00 = keep(Result(Join(a00, a01, a10, a11)));
+        Node *r01 = keep(Result(Join(a01, a02, a11, a12)));
+        Node *r10 = keep(Result(Join(a10, a11, a20, a21)));
+        Node *r11 = keep(Result(Join(a11, a12, a21, a22)));
+        r = Join(r00, r01, r10, r11);
+    }
+    m_pathRoots.resize(pathSize);
+    n->result = r;
+    return r;
+}
+
+void HashLife::Expand() {
+    Node *e = Empty(m_root->level - 1);
+    const int64_t half = int64_t(1) << (m_root->level - 1);
+    m_root = Join(Join(e, e, e, m_root->nw), Join(e, e, m_root->ne, e),
+                  Join(e, m_root->sw, e, e), Join(m_root->se, e, e, e));
+    m_originX -= half;
+    m_originY -= half;
+}
+
+bool HashLife::IsCentered() const {
+    const Node *r = m_root;
+    if (r->level < 2) return false;
+    return r->nw->nw->population == 0 && r->nw->ne->population == 0 && r->nw->sw->population == 0 &&
+           r->ne->nw->population == 0 && r->ne->ne->population == 0 && r->ne->se->population == 0 &&
+           r->sw->nw->population == 0 && r->sw->sw->population == 0 && r->sw->se->population == 0 &&
+           r->se->ne->population == 0 && r->se->sw->population == 0 && r->se->se->population == 0;
+}
+
+/**
+ * @brief 推进 2^stepLog 代
+ *
+ * 先扩大根节点，直到内容位于中心一半且层级足够，再多扩大一级：
+ * 这样内容到 RESULT 区域边界至少留有 2^(L-3) 的余量，推进期间 (光速为 1) 不会越界。
+ * 取根节点的 RESULT 作为新的根节点 (层级减一，原点向内移动四分之一边长)。
+ */
+void HashLife::Step() {
+    m_pathRoots.clear();
+    if (m_nodeCount > m_maxNodes) {
+        CollectGarbage();
+    }
+
+    while (m_root->level < m_stepLog + 3 || !IsCentered()) {
+        Expand();
+    }
+    Expand();
+
+    const int64_t quarter = int64_t(1) << (m_root->level - 2);
+    m_root = Result(m_root);
+    m_originX += quarter;
+    m_originY += quarter;
+    m_generation += uint64_t(1) << m_stepLog;
+}
+
+// ==========================================
+// 细胞访问 (Cell Access)
+// ==========================================
+
+void HashLife::ExpandToContain(int64_t x, int64_t y) {
+    for (;;) {
+        const int64_t size = int64_t(1) << m_root->level;
+        if (x >= m_originX && x < m_originX + size && y >= m_originY && y < m_originY + size) return;
+        Expand();
+    }
+}
+
+void HashLife::SetCell(int64_t x, int64_t y, bool state) {
+    ExpandToContain(x, y);
+    m_root = SetCell(m_root, m_originX, m_originY, x, y, state);
+}
+
+HashLife::Node *HashLife::SetCell(Node *n, int64_t nx, int64_t ny, int64_t x, int64_t y, bool state) {
+    if (n->level == 0) return &m_leaves[state ? 1 : 0];
+
+    const int64_t half = int64_t(1) << (n->level - 1);
+    const bool east = x >= nx + half;
+    const bool south = y >= ny + half;
+    const int64_t cx = east ? nx + half : nx;
+    const int64_t cy = south ? ny + half : ny;
+    if (!south && !east) return Join(SetCell(n->nw, cx, cy, x, y, state), n->ne, n->sw, n->se);
+    if (!south) return Join(n->nw, SetCell(n->ne, cx, cy, x, y, state), n->sw, n->se);
+    if (!east) return Join(n->nw, n->ne, SetCell(n->sw, cx, cy, x, y, state), n->se);
+    return Join(n->nw, n->ne, n->sw, SetCell(n->se, cx, cy, x, y, state));
+}
+
+bool HashLife::GetCell(int64_t x, int64_t y) const {
+    const Node *n = m_root;
+    int64_t nx = m_originX;
+    int64_t ny = m_originY;
+    const int64_t size = int64_t(1) << n->level;
+    if (x < nx || x >= nx + size || y < ny || y >= ny + size) return false;
+
+    while (n->level > 0 && n->population > 0) {
+        const int64_t half = int64_t(1) << (n->level - 1);
+        const bool east = x >= nx + half;
+        const bool south = y >= ny + half;
+        if (east) nx += half;
+        if (south) ny += half;
+        n = south ? (east ? n->se : n->sw) : (east ? n->ne : n->nw);
+    }
+    return n->population > 0;
+}
+
+void HashLife::ImportRegion(int64_t x, int64_t y, const BitGrid &grid) {
+    if (grid.GetWidth() <= 0 || grid.GetHeight() <= 0) return;
+    ExpandToContain(x, y);
+    ExpandToContain(x + grid.GetWidth() - 1, y + grid.GetHeight() - 1);
+    m_root = Replace(m_root, m_originX, m_originY, grid, x, y);
+}
+
+HashLife::Node *HashLife::Replace(Node *n, int64_t nx, int64_t ny, const BitGrid &grid, int64_t wx, int64_t wy) {
+    const int64_t size = int64_t(1) << n->level;
+    if (nx >= wx + grid.GetWidth() || ny >= wy + grid.GetHeight() || nx + size <= wx || ny + size <= wy) {
+        return n; // 与区域不相交，保持不变
+    }
+    if (n->level == 0) {
+        return &m_leaves[grid.Get(static_cast<int>(nx - wx), static_cast<int>(ny - wy)) ? 1 : 0];
+    }
+
+    const int64_t half = size / 2;
+    return Join(Replace(n->nw, nx, ny, grid, wx, wy), Replace(n->ne, nx + half, ny, grid, wx, wy),
+                Replace(n->sw, nx, ny + half, grid, wx, wy), Replace(n->se, nx + half, ny + half, grid, wx, wy));
+}
+
+void HashLife::ExportRegion(int64_t x, int64_t y, BitGrid &grid) const {
+    grid.Clear();
+    Export(m_root, m_originX, m_originY, grid, x, y);
+}
+
+void HashLife::Export(const Node *n, int64_t nx, int64_t ny, BitGrid &grid, int64_t wx, int64_t wy) const {
+    if (n->population == 0) return;
+    const int64_t size = int64_t(1) << n->level;
+    if (nx >= wx + grid.GetWidth() || ny >= wy + grid.GetHeight() || nx + size <= wx || ny + size <= wy) return;
+    if (n->level == 0) {
+        grid.Set(static_cast<int>(nx - wx), static_cast<int>(ny - wy), true);
+        return;
+    }
+
+    const int64_t half = size / 2;
+    Export(n->nw, nx, ny, grid, wx, wy);
+    Export(n->ne, nx + half, ny, grid, wx, wy);
+    Export(n->sw, nx, ny + half, grid, wx, wy);
+    Export(n->se, nx + half, ny + half, grid, wx, wy);
+}
+
+// ==========================================
+// 种群查询 (Population Query)
+// ==========================================
+
+uint64_t HashLife::GetPopulation() const {
+    return m_root->population;
+}
+
+uint64_t HashLife::GetPopulation(int64_t x, int64_t y, int64_t w, int64_t h) const {
+    if (w <= 0 || h <= 0) return 0;
+    return CountRect(m_root, m_originX, m_originY, x, y, x + w, y + h);
+}
+
+uint64_t HashLife::CountRect(const Node *n, int64_t nx, int64_t ny,
+                             int64_t x0, int64_t y0, int64_t x1, int64_t y1) const {
+    if (n->population == 0) return 0;
+    const int64_t size = int64_t(1) << n->level;
+    if (nx >= x1 || ny >= y1 || nx + size <= x0 || ny + size <= y0) return 0;
+    if (nx >= x0 && ny >= y0 && nx + size <= x1 && ny + size <= y1) return n->population;
+
+    const int64_t half = size / 2;
+    return CountRect(n->nw, nx, ny, x0, y0, x1, y1) + CountRect(n->ne, nx + half, ny, x0, y0, x1, y1) +
+           CountRect(n->sw, nx, ny + half, x0, y0, x1, y1) + CountRect(n->se, nx + half, ny + half, x0, y0, x1, y1);
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "BitGrid.h"
+#include "CompiledRule.h"
+
+/**
+ * @brief HashLife 演化引擎
+ *
+ * 把无限平面表示为规范化的四叉树：内容相同的子树只存一份 (哈希共享)，
+ * 每个节点缓存 "中心区域若干代之后的结果" (RESULT)。
+ * 重复出现的结构 (枪、繁殖器、周期图案) 只需计算一次，
+ * 因此可以以 2^k 代为步长，快速推进到数十亿代之后。
+ *
+ * 与位平面网格不同，这里的宇宙是无边界的平面，不做环面环绕。
+ * 只支持不含 B0 的两态 3x3 全和 B/S 规则 (B0 会让无限的空白区域在下一代全部出生)。
+ *
+ * 节点缓存有上限：节点数超过上限时，从根节点出发标记仍在使用的节点，
+ * 回收其余节点，并丢弃指向已回收节点的 RESULT 缓存。
+ * Step 开始前检查一次；推进过程中新建节点时也检查，此时递归路径上正在使用的节点一并作为根保留，
+ * 因此一次大步长的 Step 也不会让节点数无限增长。
+ * 存活节点本身超过上限时，下一次回收推迟到节点数达到存活节点数的两倍，避免每次新建节点都回收。
+ */
+class HashLife {
+public:
+    HashLife();
+
+    ~HashLife();
+
+    HashLife(const HashLife &) = delete;
+    HashLife &operator=(const HashLife &) = delete;
+
+    /**
+     * @brief 清空宇宙 (保留规则与步长)
+     */
+    void Clear();
+
+    /**
+     * @brief 设置演化规则
+     *
+     * 规则变化会使所有 RESULT 缓存失效。
+     * @return bool 规则含 B0、为 Generations、LtL 或非全和规则时返回 false，规则不变
+     */
+    bool SetRule(const CompiledRule &rule);
+
+    /**
+     * @brief 判断规则是否可以用 HashLife 演化 (不含 B0 的两态 3x3 全和规则)
+     */
+    static bool IsRuleSupported(const CompiledRule &rule);
+
+    /**
+     * @brief 设置步长指数：每次 Step 推进 2^stepLog 代
+     *
+     * 步长变化会使所有 RESULT 缓存失效。
+     * @param stepLog 步长指数 (0 - MAX_STEP_LOG)
+     */
+    void SetStepLog(int stepLog);
+
+    int GetStepLog() const { return m_stepLog; }
+
+    /**
+     * @brief 推进 2^stepLog 代
+     */
+    void Step();
+
+    /**
+     * @brief 获取已推进的总代数
+     */
+    uint64_t GetGeneration() const { return m_generation; }
+
+    void SetCell(int64_t x, int64_t y, bool state);
+
+    bool GetCell(int64_t x, int64_t y) const;
+
+    /**
+     * @brief 用位平面网格替换宇宙中的矩形区域 (x, y, grid 宽, grid 高)
+     *
+     * 区域外的内容保持不变。
+     */
+    void ImportRegion(int64_t x, int64_t y, const BitGrid &grid);
+
+    /**
+     * @brief 把宇宙中的矩形区域 (x, y, grid 宽, grid 高) 写入位平面网格
+     *
+     * 整个网格先被清空，空子树整块跳过。
+     */
+    void ExportRegion(int64_t x, int64_t y, BitGrid &grid) const;
+
+    /**
+     * @brief 获取整个宇宙的活细胞数 (直接读根节点，O(1))
+     */
+    uint64_t GetPopulation() const;
+
+    /**
+     * @brief 获取矩形区域内的活细胞数
+     *
+     * 完全落在区域内的子树直接使用节点上记录的数量，不展开。
+     */
+    uint64_t GetPopulation(int64_t x, int64_t y, int64_t w, int64_t h) const;
+
+    /**
+     * @brief 设置节点缓存上限 (节点个数)
+     */
+    void SetMaxNodes(size_t maxNodes) {
+        m_maxNodes = maxNodes;
+        m_collectThreshold = maxNodes;
+    }
+
+    size_t GetNodeCount() const { return m_nodeCount; }
+
+    /**
+     * @brief 立即回收不再被根节点引用的节点
+     */
+    void CollectGarbage();
+
+    static constexpr int MAX_STEP_LOG = 48; ///< 最大步长指数
+    static constexpr size_t DEFAULT_MAX_NODES = size_t(1) << 21; ///< 默认节点上限 (约 2M 个节点)
+
+private:
+    /**
+     * @brief 四叉树节点
+     *
+     * level 0 为单个细胞，level L 的节点边长为 2^L。
+     */
+    struct Node {
+        Node *nw; ///< 西北子节点
+        Node *ne; ///< 东北子节点
+        Node *sw; ///< 西南子节点
+        Node *se; ///< 东南子节点
+        Node *result; ///< 中心 2^(L-1) 区域推进 2^min(stepLog, L-2) 代后的结果 (缓存)
+        Node *next; ///< 哈希桶链表 / 空闲链表
+        uint64_t population; ///< 活细胞数
+        int level; ///< 层级
+        bool marked; ///< 垃圾回收标记
+    };
+
+    Node *AllocNode();
+
+    /**
+     * @brief 查找或创建由四个子节点组成的规范节点
+     *
+     * 推进过程中需要新建节点且节点数达到回收阈值时，先以四个子节点与 m_pathRoots 为根回收垃圾。
+     */
+    Node *Join(Node *nw, Node *ne, Node *sw, Node *se);
+
+    Node *Empty(int level);
+
+    /**
+     * @brief 计算节点的 RESULT (带缓存)
+     *
+     * 递归期间把 n 与已求出的中间节点压入 m_pathRoots，返回前弹出。
+     */
+    Node *Result(Node *n);
+
+    /**
+     * @brief 4x4 基本情形：直接按规则计算中心 2x2 一代之后的状态
+     */
+    Node *BaseResult(Node *n);
+
+    Node *Centre(Node *n);
+
+    /**
+     * @brief 把根节点扩大一级，原内容居中
+     */
+    void Expand();
+
+    /**
+     * @brief 内容是否都在根节点的中心一半区域内
+     */
+    bool IsCentered() const;
+
+    /**
+     * @brief 扩大根节点直到包含坐标 (x, y)
+     */
+    void ExpandToContain(int64_t x, int64_t y);
+
+    Node *SetCell(Node *n, int64_t nx, int64_t ny, int64_t x, int64_t y, bool state);
+
+    Node *Replace(Node *n, int64_t nx, int64_t ny, const BitGrid &grid, int64_t wx, int64_t wy);
+
+    void Export(const Node *n, int64_t nx, int64_t ny, BitGrid &grid, int64_t wx, int64_t wy) const;
+
+    uint64_t CountRect(const Node *n, int64_t nx, int64_t ny, int64_t x0, int64_t y0, int64_t x1, int64_t y1) const;
+
+    void ClearResults();
+
+    void Mark(Node *n);
+
+    void Rehash(size_t bucketCount);
+
+    static size_t HashChildren(const Node *nw, const Node *ne, const Node *sw, const Node *se);
+
+    // 节点存储
+    std::vector<std::unique_ptr<Node[]> > m_blocks; ///< 节点内存块
+    Node *m_freeList; ///< 空闲节点链表
+    std::vector<Node *> m_buckets; ///< 哈希桶 (桶数为 2 的幂)
+    size_t m_nodeCount; ///< 哈希表中的节点数
+    size_t m_maxNodes; ///< 节点缓存上限
+    size_t m_collectThreshold; ///< 推进过程中触发回收的节点数 (不低于上限)
+    std::vector<Node *> m_pathRoots; ///< 推进过程中递归路径上正在使用的节点 (回收时作为根)
+    Node m_leaves[2]; ///< 两个叶子节点 (死/活细胞)，不进入哈希表
+    std::vector<Node *> m_emptyNodes; ///< 各层级的空节点
+
+    // 宇宙状态
+    Node *m_root; ///< 根节点
+    int64_t m_originX; ///< 根节点左上角的 X 坐标
+    int64_t m_originY; ///< 根节点左上角的 Y 坐标
+    uint64_t m_generation; ///< 已推进的代数
+    int m_stepLog; ///< 步长指数
+    CompiledRule m_rule; ///< 当前规则
+};
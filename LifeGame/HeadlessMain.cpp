@@ -0,0 +1,224 @@
+#include "Game.h"
+#include "MultiProcessRunner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief 逐细胞参考演化一代 (供本进程内演化的 -verify 使用)
+ *
+ * cells 为逐细胞的状态 (0 死，1 活，2 .. 状态数-1 衰减中)。邻居直接按拓扑策略映射后读取，
+ * 下一状态按规则定义逐个计算，与幽灵细胞、行内核、分块调度和时间分块完全独立。
+ */
+static void StepReference(const CompiledRule &rule, BoundaryTopology topology, int width, int height,
+                          const std::vector<uint8_t> &cells, std::vector<uint8_t> &next) {
+    auto alive = [&](int x, int y) -> int {
+        if (x < 0 || x >= width || y < 0 || y >= height) {
+            bool inside = false;
+            switch (topology) {
+                case BoundaryTopology::Torus: inside = TorusTopology::Map(x, y, width, height); break;
+                case BoundaryTopology::DeadEdge: inside = DeadEdgeTopology::Map(x, y, width, height); break;
+                case BoundaryTopology::KleinBottle: inside = KleinBottleTopology::Map(x, y, width, height); break;
+                case BoundaryTopology::CrossSurface: inside = CrossSurfaceTopology::Map(x, y, width, height); break;
+            }
+            if (!inside) return 0;
+        }
+        return cells[static_cast<size_t>(y) * width + x] == 1 ? 1 : 0;
+    };
+
+    const LtlRule &ltl = rule.ltl;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int state = cells[static_cast<size_t>(y) * width + x];
+            int result;
+            if (state >= 2) {
+                result = state + 1 < rule.states ? state + 1 : 0;
+            } else {
+                bool on;
+                if (rule.IsLargerThanLife()) {
+                    int n = 0;
+                    for (int dy = -ltl.radius; dy <= ltl.radius; dy++) {
+                        const int span = ltl.vonNeumann ? ltl.radius - (dy < 0 ? -dy : dy) : ltl.radius;
+                        for (int dx = -span; dx <= span; dx++) {
+                            if (dx != 0 || dy != 0 || ltl.countCenter) n += alive(x + dx, y + dy);
+                        }
+                    }
+                    on = state == 1 ? (n >= ltl.survivalMin && n <= ltl.survivalMax)
+                                    : (n >= ltl.birthMin && n <= ltl.birthMax);
+                } else {
+                    unsigned index = 0;
+                    for (int bit = 0; bit < 9; ++bit) {
+                        index |= static_cast<unsigned>(alive(x + bit % 3 - 1, y + bit / 3 - 1)) << bit;
+                    }
+                    on = rule.NextStateFromNeighborhood(index);
+                }
+                result = on ? 1 : (state == 1 && rule.IsGenerations() ? 2 : 0);
+            }
+            next[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>(result);
+        }
+    }
+}
+
+/**
+ * @brief 无界面协调程序入口 (控制台程序)
+ *
+ * 用法: LifeGameHeadless [-w 宽] [-h 高] [-n 代数] [-rule 规则] [-seed 种子]
+ *                        [-topology torus|dead|klein|cross] [-p 进程数] [-verify] [-stats 文件]
+ *
+ * 用 LifeGame 建立初始状态 (随机种子、规则、拓扑)，再把网格按行分给 -p 个本地进程，
+ * 通过共享内存交换 Halo 行演化 -n 代 (见 MultiProcessRunner)。
+ * -p 0 或规则/拓扑不支持分解时直接在本进程内用 LifeGame::Step 演化。
+ * -verify 时多进程结果与 LifeGame::Step 在本进程内演化同样代数的结果逐位比较；
+ * 本进程内演化时则与逐细胞参考演化 (StepReference) 逐状态比较。不一致时返回 1。
+ * -stats 把每一代的人口、出生/死亡、外接矩形与棋盘哈希写入文件 (见 StatisticsSink)，
+ * 扩展名为 .csv 时写文本，否则写按列二进制；逐代记录只有本进程内演化才有，因此这时不使用多进程。
+ * 未知的拓扑名返回 2；只有显式给出 -p 时才提示改为本进程内演化。
+ */
+int main(int argc, char **argv) {
+    int width = 2000;
+    int height = 2000;
+    int generations = 100;
+    int processCount = 1;
+    bool processCountGiven = false;
+    unsigned long long seed = 12345;
+    const char *ruleString = "B3/S23";
+    BoundaryTopology topology = BoundaryTopology::Torus;
+    bool verify = false;
+    const char *statsPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "-cols") == 0) && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "-rows") == 0) && i + 1 < argc) {
+            height = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            generations = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            processCount = atoi(argv[++i]);
+            processCountGiven = true;
+        } else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "-rule") == 0 && i + 1 < argc) {
+            ruleString = argv[++i];
+        } else if (strcmp(argv[i], "-topology") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            if (strcmp(name, "torus") == 0) topology = BoundaryTopology::Torus;
+            else if (strcmp(name, "dead") == 0) topology = BoundaryTopology::DeadEdge;
+            else if (strcmp(name, "klein") == 0) topology = BoundaryTopology::KleinBottle;
+            else if (strcmp(name, "cross") == 0) topology = BoundaryTopology::CrossSurface;
+            else {
+                fprintf(stderr, "Unknown topology: %s (expected torus, dead, klein or cross)\n", name);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-verify") == 0) {
+            verify = true;
+        } else if (strcmp(argv[i], "-stats") == 0 && i + 1 < argc) {
+            statsPath = argv[++i];
+        }
+    }
+    if (generations < 0) generations = 0;
+
+    LifeGame game(width, height);
+    int ruleIndex = game.FindRule(ruleString);
+    if (ruleIndex < 0) ruleIndex = game.AddCustomRule(L"Custom", ruleString);
+    if (ruleIndex < 0 || !game.SetRule(ruleIndex)) {
+        fprintf(stderr, "Invalid rule or not enough memory: %s\n", ruleString);
+        return 2;
+    }
+    game.SetTopology(topology);
+    game.InitGrid(seed);
+    width = game.GetWidth();
+    height = game.GetHeight();
+
+    const CompiledRule &rule = *game.GetRuleEngine().GetCompiledRule(game.GetRuleIndex());
+    const bool distributed = processCount > 0 && statsPath == nullptr && MultiProcessRunner::IsAvailable() &&
+                             MultiProcessRunner::IsSupported(topology, rule);
+    printf("Grid %dx%d, rule %s, %d generations, seed %llu\n", width, height, ruleString, generations, seed);
+
+    if (!distributed) {
+        if (processCountGiven && processCount > 0) {
+            if (statsPath != nullptr) printf("Per-generation statistics require an in-process run\n");
+            else printf("Multi-process mode unavailable for this platform/rule, running in-process\n");
+        }
+
+        std::vector<uint8_t> reference;
+        if (verify) {
+            reference.resize(static_cast<size_t>(width) * height);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    reference[static_cast<size_t>(y) * width + x] = static_cast<uint8_t>(game.GetCellState(x, y));
+                }
+            }
+        }
+
+        StatisticsSink sink;
+        if (statsPath != nullptr) {
+            const size_t length = strlen(statsPath);
+            const bool csv = length >= 4 && strcmp(statsPath + length - 4, ".csv") == 0;
+            if (!sink.Open(statsPath, csv ? SinkFormat::Csv : SinkFormat::Binary)) {
+                fprintf(stderr, "%s\n", sink.GetLastError().c_str());
+                return 1;
+            }
+            game.SetStatisticsSink(&sink);
+        }
+
+        const StepSummary summary = game.Step(generations);
+        printf("In-process: %.4f ms/gen, population %lld\n",
+               generations > 0 ? summary.elapsedMs / generations : 0.0, game.GetPopulation());
+
+        if (statsPath != nullptr) {
+            game.SetStatisticsSink(nullptr);
+            const bool ok = sink.Close();
+            printf("Statistics: %llu records written, %llu dropped\n", sink.GetWrittenCount(), sink.GetDroppedCount());
+            if (!ok) {
+                fprintf(stderr, "%s\n", sink.GetLastError().c_str());
+                return 1;
+            }
+        }
+
+        if (verify) {
+            std::vector<uint8_t> scratch(reference.size());
+            const auto start = std::chrono::steady_clock::now();
+            for (int gen = 0; gen < generations; gen++) {
+                StepReference(rule, topology, width, height, reference, scratch);
+                reference.swap(scratch);
+            }
+            const auto end = std::chrono::steady_clock::now();
+            const double elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+            bool match = true;
+            for (int y = 0; y < height && match; y++) {
+                for (int x = 0; x < width; x++) {
+                    if (reference[static_cast<size_t>(y) * width + x] != game.GetCellState(x, y)) {
+                        match = false;
+                        break;
+                    }
+                }
+            }
+            printf("Per-cell reference: %.4f ms/gen, %s\n", generations > 0 ? elapsedMs / generations : 0.0,
+                   match ? "OK" : "MISMATCH");
+            if (!match) return 1;
+        }
+        return 0;
+    }
+
+    BitGrid grid = game.GetGrid();
+    MultiProcessRunner runner;
+    if (!runner.Run(SelectStepRow(GetActiveKernelTable(), rule), topology, grid, processCount, generations, rule)) {
+        fprintf(stderr, "Multi-process run failed: %s\n", runner.GetLastError().c_str());
+        return 1;
+    }
+    printf("%d processes: %.4f ms/gen, population %lld\n", runner.GetLastProcessCount(),
+           generations > 0 ? runner.GetLastElapsedMs() / generations : 0.0, grid.CountPopulation());
+
+    if (verify) {
+        const StepSummary summary = game.Step(generations);
+        const bool match = game.GetGrid().Equals(grid);
+        printf("In-process reference: %.4f ms/gen, %s\n", generations > 0 ? summary.elapsedMs / generations : 0.0,
+               match ? "OK" : "MISMATCH");
+        if (!match) return 1;
+    }
+    return 0;
+}
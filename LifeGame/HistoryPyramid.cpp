@@ -0,0 +1,94 @@
+#include "HistoryPyramid.h"
+
+static const HistoryBucket EMPTY_BUCKET = {0, 0, 0, 0};
+
+/**
+ * @brief 把一个桶并入另一个桶
+ */
+static void MergeBucket(HistoryBucket &into, const HistoryBucket &from) {
+    if (from.count == 0) return;
+    if (into.count == 0) {
+        into = from;
+        return;
+    }
+    if (from.min < into.min) into.min = from.min;
+    if (from.max > into.max) into.max = from.max;
+    into.sum += from.sum;
+    into.count += from.count;
+}
+
+HistoryPyramid::HistoryPyramid() : m_count(0) {
+    for (Level &level: m_levels) {
+        level.ring.assign(LEVEL_CAPACITY, EMPTY_BUCKET);
+    }
+    Clear();
+}
+
+void HistoryPyramid::Clear() {
+    for (Level &level: m_levels) {
+        level.closed = 0;
+        level.open = EMPTY_BUCKET;
+    }
+    m_count = 0;
+}
+
+/**
+ * @brief 追加一帧
+ *
+ * 各层的桶都从第 0 帧开始按自己的大小对齐，因此每层独立累积即可，不需要逐层向上合并。
+ */
+void HistoryPyramid::Push(long long value) {
+    const HistoryBucket sample = {value, value, value, 1};
+    for (int l = 0; l < LEVEL_COUNT; ++l) {
+        Level &level = m_levels[l];
+        MergeBucket(level.open, sample);
+        if (level.open.count == BucketSize(l)) {
+            level.ring[static_cast<size_t>(level.closed % LEVEL_CAPACITY)] = level.open;
+            level.closed++;
+            level.open = EMPTY_BUCKET;
+        }
+    }
+    m_count++;
+}
+
+long long HistoryPyramid::OldestFrame(int level) const {
+    const long long dropped = m_levels[level].closed - LEVEL_CAPACITY;
+    return dropped > 0 ? dropped * BucketSize(level) : 0;
+}
+
+/**
+ * @brief 查询一段帧的汇总
+ *
+ * 先选桶大小不超过每列帧数的最粗一层；如果这一层已经丢掉了范围开头的数据，再逐层变粗直到能覆盖为止。
+ */
+int HistoryPyramid::Query(long long first, long long last, int columns, std::vector<HistoryBucket> &out) const {
+    out.clear();
+    if (first < 0) first = 0;
+    if (last > m_count) last = m_count;
+    if (columns <= 0 || last <= first) return 0;
+
+    int l = 0;
+    while (l + 1 < LEVEL_COUNT && BucketSize(l + 1) * columns <= last - first) {
+        l++;
+    }
+    while (l + 1 < LEVEL_COUNT && OldestFrame(l) > first) {
+        l++;
+    }
+    if (OldestFrame(l) > first) first = OldestFrame(l);
+    const long long span = last - first;
+    if (columns > span) columns = static_cast<int>(span);
+
+    const Level &level = m_levels[l];
+    const long long size = BucketSize(l);
+    out.resize(columns);
+    for (int c = 0; c < columns; ++c) {
+        const long long begin = first + span * c / columns;
+        const long long end = first + span * (c + 1) / columns;
+        HistoryBucket bucket = EMPTY_BUCKET;
+        for (long long i = begin / size; i <= (end - 1) / size; ++i) {
+            MergeBucket(bucket, i < level.closed ? level.ring[static_cast<size_t>(i % LEVEL_CAPACITY)] : level.open);
+        }
+        out[c] = bucket;
+    }
+    return l;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 一段连续帧的汇总
+ */
+struct HistoryBucket {
+    long long min; ///< 最小值
+    long long max; ///< 最大值
+    long long sum; ///< 总和 (平均值 = sum / count)
+    long long count; ///< 包含的帧数 (为 0 表示空)
+};
+
+/**
+ * @brief 多分辨率历史金字塔
+ *
+ * 第 L 层把每 FANOUT^L 帧 (1, 16, 256, ...) 汇总为一个桶 (最小/最大/总和)，
+ * 每层只保留最近 LEVEL_CAPACITY 个桶 (环形缓冲)，因此总内存固定，
+ * 第 L 层能回看 LEVEL_CAPACITY x FANOUT^L 帧，最高层可以覆盖 10^12 帧以上。
+ *
+ * 每帧只更新各层正在累积的桶 (O(LEVEL_COUNT))。绘制时按列数选择桶大小不超过 "每列帧数" 的最粗一层，
+ * 每列只合并不到 FANOUT 个桶，任意缩放范围的查询都是 O(列数)，与总帧数无关。
+ */
+class HistoryPyramid {
+public:
+    static constexpr int FANOUT = 16; ///< 相邻两层桶大小之比
+    static constexpr int LEVEL_COUNT = 8; ///< 层数 (最粗一层每桶 16^7 帧)
+    static constexpr int LEVEL_CAPACITY = 4096; ///< 每层保留的桶数
+
+    HistoryPyramid();
+
+    /**
+     * @brief 清空全部历史
+     */
+    void Clear();
+
+    /**
+     * @brief 追加一帧的值
+     */
+    void Push(long long value);
+
+    /**
+     * @brief 已经追加的总帧数
+     */
+    long long GetCount() const { return m_count; }
+
+    /**
+     * @brief 把帧 [first, last) 汇总为 columns 列
+     *
+     * 范围会被裁剪到仍保留在金字塔中的帧，列数多于帧数时每列一帧。
+     * 列边界按所选层的桶对齐，相邻两列可能共享一个桶。
+     * @param out 输出，每列一个桶 (out 的容量会被复用)
+     * @return int 使用的层 (每桶 FANOUT^层 帧)
+     */
+    int Query(long long first, long long last, int columns, std::vector<HistoryBucket> &out) const;
+
+private:
+    /**
+     * @brief 金字塔的一层
+     */
+    struct Level {
+        std::vector<HistoryBucket> ring; ///< 已完成的桶 (下标为桶序号对 LEVEL_CAPACITY 取模)
+        long long closed; ///< 已完成的桶数 (正在累积的桶的序号)
+        HistoryBucket open; ///< 正在累积的桶
+    };
+
+    /**
+     * @brief 第 level 层每个桶包含的帧数
+     */
+    static long long BucketSize(int level) { return 1LL << (4 * level); }
+
+    /**
+     * @brief 第 level 层仍保留的最早一帧
+     */
+    long long OldestFrame(int level) const;
+
+    Level m_levels[LEVEL_COUNT]; ///< 各层 (第 0 层即原始数据)
+    long long m_count; ///< 总帧数
+};
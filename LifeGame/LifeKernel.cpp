@@ -0,0 +1,161 @@
+#include "LifeKernel.h"
+#include <algorithm>
+
+/**
+ * @brief 计算第 i 个字的西邻居平面
+ *
+ * 结果的第 j 位是细胞 (64*i + j - 1)。第 0 个字的第 0 位取自西侧幽灵细胞。
+ */
+static inline uint64_t WestOf(const uint64_t *row, int i, uint64_t ghost) {
+    const uint64_t carry = (i > 0) ? (row[i - 1] >> 63) : ghost;
+    return (row[i] << 1) | carry;
+}
+
+/**
+ * @brief 计算第 i 个字的东邻居平面
+ *
+ * 结果的第 j 位是细胞 (64*i + j + 1)。
+ * 对于最后一个字，row[i] >> 1 在最后一列位置上移入的是填充位 (恒为 0)，再补上东侧幽灵细胞即可。
+ */
+static inline uint64_t EastOf(const uint64_t *row, int i, int wordsPerRow, int width, uint64_t ghost) {
+    if (i + 1 < wordsPerRow) {
+        return (row[i] >> 1) | (row[i + 1] << 63);
+    }
+    return (row[i] >> 1) | (ghost << ((width - 1) & 63));
+}
+
+/**
+ * @brief 计算一行中指定字范围的下一代
+ */
+void StepWordsSwar(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                   int firstWord, int lastWord, int wordsPerRow, int width, GhostCells ghosts,
+                   const CompiledRule &rule) {
+    const RuntimeRule masks(rule);
+    const uint64_t aw = ghosts.west & 1u, cw = (ghosts.west >> 1) & 1u, bw = (ghosts.west >> 2) & 1u;
+    const uint64_t ae = ghosts.east & 1u, ce = (ghosts.east >> 1) & 1u, be = (ghosts.east >> 2) & 1u;
+    for (int i = firstWord; i < lastWord; ++i) {
+        uint64_t s0, s1, s2, s3;
+        SumNeighbors<ScalarOps>(WestOf(above, i, aw), above[i], EastOf(above, i, wordsPerRow, width, ae),
+                                WestOf(row, i, cw), EastOf(row, i, wordsPerRow, width, ce),
+                                WestOf(below, i, bw), below[i], EastOf(below, i, wordsPerRow, width, be),
+                                s0, s1, s2, s3);
+        out[i] = ApplyRule<ScalarOps>(s0, s1, s2, s3, row[i], masks);
+    }
+}
+
+/**
+ * @brief 计算一行中指定字范围的下一代并清除填充位
+ */
+void StepRowSwar(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                 int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                 GhostCells ghosts, const CompiledRule &rule) {
+    StepWordsSwar(above, row, below, out, firstWord, lastWord, wordsPerRow, width, ghosts, rule);
+    // 清除填充位，维持 BitGrid 的不变量
+    if (lastWord == wordsPerRow) {
+        out[wordsPerRow - 1] &= lastWordMask;
+    }
+}
+
+/**
+ * @brief 取第 i 个字对应的 66 个细胞窗口 (细胞 64*i - 1 .. 64*i + 64)
+ *
+ * lo 的第 k 位为细胞 64*i + k - 1，hi 的低 2 位为细胞 64*i + 63 与 64*i + 64。
+ * 东侧从 EastOf 平面取，最后一个字的东侧幽灵细胞因此自动落在正确的位置。
+ */
+static inline void CellWindow(const uint64_t *row, int i, int wordsPerRow, int width, uint64_t westGhost,
+                              uint64_t eastGhost, uint64_t &lo, uint64_t &hi) {
+    const uint64_t east = EastOf(row, i, wordsPerRow, width, eastGhost);
+    lo = (WestOf(row, i, westGhost) & 3u) | (east << 2);
+    hi = east >> 62;
+}
+
+/**
+ * @brief 取窗口中以第 j 个细胞为中心的 3 位 (西、中、东)
+ */
+static inline unsigned Triple(uint64_t lo, uint64_t hi, int j) {
+    const uint64_t bits = j < 62 ? (lo >> j) : ((lo >> j) | (hi << (64 - j)));
+    return static_cast<unsigned>(bits & 7u);
+}
+
+/**
+ * @brief 用 512 项邻域表计算一行中指定字范围的下一代
+ *
+ * 邻域网络已生成时，9 个邻居平面与 StepWordsSwar 的取法相同，整字对网络求值；
+ * 否则逐细胞拼下标：窗口按字准备，每个细胞只需三次移位与一次查表。
+ */
+void StepWordsLut(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                  int firstWord, int lastWord, int wordsPerRow, int width, GhostCells ghosts,
+                  const CompiledRule &rule) {
+    if (rule.network.built) {
+        const uint64_t aw = ghosts.west & 1u, cw = (ghosts.west >> 1) & 1u, bw = (ghosts.west >> 2) & 1u;
+        const uint64_t ae = ghosts.east & 1u, ce = (ghosts.east >> 1) & 1u, be = (ghosts.east >> 2) & 1u;
+        for (int i = firstWord; i < lastWord; ++i) {
+            const uint64_t planes[9] = {
+                WestOf(above, i, aw), above[i], EastOf(above, i, wordsPerRow, width, ae),
+                WestOf(row, i, cw), row[i], EastOf(row, i, wordsPerRow, width, ce),
+                WestOf(below, i, bw), below[i], EastOf(below, i, wordsPerRow, width, be)
+            };
+            out[i] = EvalNeighborhoodNetwork<ScalarOps>(planes, rule.network);
+        }
+        return;
+    }
+
+    const uint64_t *table = rule.neighborhood;
+    for (int i = firstWord; i < lastWord; ++i) {
+        uint64_t aLo, aHi, cLo, cHi, bLo, bHi;
+        CellWindow(above, i, wordsPerRow, width, ghosts.west & 1u, ghosts.east & 1u, aLo, aHi);
+        CellWindow(row, i, wordsPerRow, width, (ghosts.west >> 1) & 1u, (ghosts.east >> 1) & 1u, cLo, cHi);
+        CellWindow(below, i, wordsPerRow, width, (ghosts.west >> 2) & 1u, (ghosts.east >> 2) & 1u, bLo, bHi);
+
+        const int count = std::min(64, width - i * 64);
+        uint64_t next = 0;
+        for (int j = 0; j < count; ++j) {
+            const unsigned index = Triple(aLo, aHi, j) | (Triple(cLo, cHi, j) << 3) | (Triple(bLo, bHi, j) << 6);
+            next |= ((table[index >> 6] >> (index & 63)) & 1ULL) << j;
+        }
+        out[i] = next;
+    }
+}
+
+/**
+ * @brief 用 512 项邻域表计算一行中指定字范围的下一代并清除填充位
+ */
+void StepRowLut(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                GhostCells ghosts, const CompiledRule &rule) {
+    StepWordsLut(above, row, below, out, firstWord, lastWord, wordsPerRow, width, ghosts, rule);
+    if (lastWord == wordsPerRow) {
+        out[wordsPerRow - 1] &= lastWordMask;
+    }
+}
+
+/**
+ * @brief Generations 衰减处理
+ *
+ * 每个字节的更新只有比较与选择，没有跨字节依赖，编译器可以自动向量化内层循环。
+ */
+bool ApplyDecayRow(const uint8_t *states, uint8_t *nextStates, uint64_t *nextAlive,
+                   int firstWord, int lastWord, int width, int stateCount) {
+    uint8_t diff = 0;
+    for (int i = firstWord; i < lastWord; ++i) {
+        const int x0 = i * 64;
+        const int count = std::min(64, width - x0);
+        const uint8_t *in = states + x0;
+        uint8_t *out = nextStates + x0;
+        const uint64_t born = nextAlive[i];
+
+        uint64_t alive = 0;
+        for (int j = 0; j < count; ++j) {
+            const uint8_t s = in[j];
+            uint8_t aged = s ? static_cast<uint8_t>(s + 1) : 0; // 活细胞 (1) 进入衰减态 2
+            if (aged >= stateCount) aged = 0;
+            const bool on = ((born >> j) & 1ULL) != 0 && s < 2; // 衰减中的细胞不能出生
+            const uint8_t next = on ? 1 : aged;
+            out[j] = next;
+            diff |= static_cast<uint8_t>(next ^ s);
+            alive |= static_cast<uint64_t>(on) << j;
+        }
+        nextAlive[i] = alive;
+    }
+    return diff != 0;
+}
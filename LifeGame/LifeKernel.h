@@ -0,0 +1,392 @@
+#pragma once
+#include <cstdint>
+#include "BitGrid.h"
+#include "CompiledRule.h"
+
+/**
+ * @brief 位并行 (SWAR) 演化内核
+ *
+ * 一次处理一个 64 位字，即 64 个细胞：
+ * 1. 把上、中、下三行分别左右移 1 位，得到 8 个邻居方向的位平面；
+ * 2. 用全加器/半加器逻辑把 8 个 1 bit 输入按位相加，得到 4 个"和位"平面 (s0..s3，表示 0-8)；
+ * 3. 把 B/S 规则表示为和位的布尔函数，直接得到下一代的 64 个细胞。
+ *
+ * 整个过程只有位运算，没有逐细胞分支、取模或集合查找。
+ * 加法器与规则求值写成以 "向量操作集 (Ops)" 为参数的模板，
+ * 标量、SSE2、AVX2 三条路径共用同一份逻辑，只是一次处理的字数不同。
+ * 规则同样作为模板参数 (Rule)：RuntimeRule 在运行时读取掩码，
+ * StaticRule 把掩码固定为编译期常量，供内置规则生成特化内核。
+ */
+
+/**
+ * @brief 标量操作集：一次处理 1 个 64 位字
+ */
+struct ScalarOps {
+    typedef uint64_t V;
+    static constexpr int LANES = 1; ///< 每个向量包含的 64 位字数
+
+    static V LoadU(const uint64_t *p) { return *p; }
+    static void StoreU(uint64_t *p, V v) { *p = v; }
+    static V And(V a, V b) { return a & b; }
+    static V Or(V a, V b) { return a | b; }
+    static V Xor(V a, V b) { return a ^ b; }
+    static V Not(V a) { return ~a; }
+    static V Zero() { return 0; }
+    static V Shl1(V a) { return a << 1; }
+    static V Shr1(V a) { return a >> 1; }
+    static V Shl63(V a) { return a << 63; }
+    static V Shr63(V a) { return a >> 63; }
+};
+
+/**
+ * @brief 运行时规则：出生/存活掩码取自 CompiledRule
+ *
+ * 适用于任意规则 (包括用户自定义规则)，ApplyRule 中的分支在运行时判断。
+ */
+struct RuntimeRule {
+    uint16_t birth; ///< 出生掩码
+    uint16_t survival; ///< 存活掩码
+
+    explicit RuntimeRule(const CompiledRule &rule)
+        : birth(rule.GetBirthMask()), survival(rule.GetSurvivalMask()) {
+    }
+};
+
+/**
+ * @brief 编译期规则：出生/存活掩码是模板参数
+ *
+ * ApplyRule 按规则的真值表在编译期展开为最简的布尔网络 (见 RuleNetwork)，
+ * 不再逐个构造 "邻居数 == n" 的比较项。
+ * 构造函数忽略传入的 CompiledRule，只是为了与 RuntimeRule 接口一致。
+ */
+template <uint16_t BIRTH, uint16_t SURVIVAL>
+struct StaticRule {
+    static constexpr uint16_t birth = BIRTH;
+    static constexpr uint16_t survival = SURVIVAL;
+
+    explicit StaticRule(const CompiledRule &) {
+    }
+};
+
+/**
+ * @brief 一行计算所需的边界幽灵细胞
+ *
+ * 第 0/1/2 位分别对应上一行、当前行、下一行在网格外的那个细胞。
+ * 由 BoundaryHalo 按拓扑每代刷新一次，行内核只负责把它们移入行首/行尾字。
+ */
+struct GhostCells {
+    uint8_t west; ///< 第 -1 列
+    uint8_t east; ///< 第 width 列
+};
+
+/**
+ * @brief 三个 1 bit 输入的全加器
+ * @param sum 输出：和位 (权重 1)
+ * @param carry 输出：进位 (权重 2)
+ */
+template <class Ops>
+inline void FullAdd(typename Ops::V a, typename Ops::V b, typename Ops::V c,
+                    typename Ops::V &sum, typename Ops::V &carry) {
+    const typename Ops::V t = Ops::Xor(a, b);
+    sum = Ops::Xor(t, c);
+    carry = Ops::Or(Ops::And(a, b), Ops::And(t, c));
+}
+
+/**
+ * @brief 两个 1 bit 输入的半加器
+ */
+template <class Ops>
+inline void HalfAdd(typename Ops::V a, typename Ops::V b, typename Ops::V &sum, typename Ops::V &carry) {
+    sum = Ops::Xor(a, b);
+    carry = Ops::And(a, b);
+}
+
+/**
+ * @brief 按位统计 8 个邻居平面之和
+ *
+ * 输入为三行各自的 西/中/东 平面 (中间行不含自身)，输出 4 个和位平面，
+ * 每个位置上 s0 + 2*s1 + 4*s2 + 8*s3 即该细胞的活邻居数。
+ */
+template <class Ops>
+inline void SumNeighbors(typename Ops::V aw, typename Ops::V a, typename Ops::V ae,
+                         typename Ops::V cw, typename Ops::V ce,
+                         typename Ops::V bw, typename Ops::V b, typename Ops::V be,
+                         typename Ops::V &s0, typename Ops::V &s1, typename Ops::V &s2, typename Ops::V &s3) {
+    typename Ops::V a1, a2, b1, b2, c1, c2;
+    FullAdd<Ops>(aw, a, ae, a1, a2); // 上一行：和 0-3
+    FullAdd<Ops>(bw, b, be, b1, b2); // 下一行：和 0-3
+    HalfAdd<Ops>(cw, ce, c1, c2); // 本行左右：和 0-2
+
+    typename Ops::V k1;
+    FullAdd<Ops>(a1, b1, c1, s0, k1); // 权重 1 位，进位 k1 权重 2
+
+    typename Ops::V t1, t2, t3;
+    FullAdd<Ops>(a2, b2, c2, t1, t2); // 三个权重 2 的输入
+    HalfAdd<Ops>(t1, k1, s1, t3); // 加上低位进位
+    HalfAdd<Ops>(t2, t3, s2, s3); // 权重 4 与权重 8
+}
+
+/**
+ * @brief 编译期规则的真值表
+ *
+ * 下标第 0 位为当前细胞，第 1-4 位为和位 s0..s3 (即邻居数)。
+ */
+constexpr uint32_t StaticRuleTruthTable(uint16_t birth, uint16_t survival) {
+    uint32_t table = 0;
+    for (int i = 0; i < 32; ++i) {
+        const int count = i >> 1;
+        const uint16_t mask = (i & 1) ? survival : birth;
+        if (count <= 8 && ((mask >> count) & 1u)) table |= 1u << i;
+    }
+    return table;
+}
+
+constexpr uint32_t STATIC_RULE_CARE = 0x3FFFF; ///< 真值表中可能出现的下标 (邻居数不超过 8)，其余为无关项
+
+/**
+ * @brief 真值表的一半 (最高变量为 0 或 1 时的子表)
+ */
+constexpr uint32_t RuleTableHalf(uint32_t table, int vars, bool high) {
+    return (high ? table >> (1 << (vars - 1)) : table) & ((1u << (1 << (vars - 1))) - 1);
+}
+
+/**
+ * @brief 展开真值表时，最高变量 v 与两个子表 (Lo: v = 0，Hi: v = 1) 的组合方式
+ */
+enum class RuleNodeKind { Zero, One, Ignore, AndNot, Or, And, OrNot, Xor, Select };
+
+constexpr RuleNodeKind ClassifyRuleNode(uint32_t table, uint32_t care, int vars) {
+    if ((table & care) == 0) return RuleNodeKind::Zero;
+    if ((table & care) == care) return RuleNodeKind::One;
+    const uint32_t loT = RuleTableHalf(table, vars, false), loC = RuleTableHalf(care, vars, false);
+    const uint32_t hiT = RuleTableHalf(table, vars, true), hiC = RuleTableHalf(care, vars, true);
+    if (((loT ^ hiT) & loC & hiC) == 0) return RuleNodeKind::Ignore; // 结果与 v 无关
+    if ((hiT & hiC) == 0) return RuleNodeKind::AndNot; // ~v & Lo
+    if ((hiT & hiC) == hiC) return RuleNodeKind::Or; // v | Lo
+    if ((loT & loC) == 0) return RuleNodeKind::And; // v & Hi
+    if ((loT & loC) == loC) return RuleNodeKind::OrNot; // ~v | Hi
+    if (((loT ^ ~hiT) & loC & hiC) == 0) return RuleNodeKind::Xor; // v ^ Lo
+    return RuleNodeKind::Select;
+}
+
+/**
+ * @brief 编译期规则的布尔网络
+ *
+ * 按 s3, s2, s1, s0, 当前细胞的顺序对真值表做香农展开：每一层按两个子表的关系选择最简的组合，
+ * 邻居数超过 8 的下标作为无关项参与合并。例如 B3/S23 展开为 ~s2 & s1 & (s0 | alive)，
+ * 比逐个构造 "邻居数 == n" 再合并少得多。vars[k] 为第 k 个变量 (0 为当前细胞，1-4 为 s0..s3)。
+ */
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS,
+          RuleNodeKind KIND = ClassifyRuleNode(TABLE, CARE, VARS)>
+struct RuleNetwork;
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::Zero> {
+    static typename Ops::V Eval(const typename Ops::V *) { return Ops::Zero(); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::One> {
+    static typename Ops::V Eval(const typename Ops::V *) { return Ops::Not(Ops::Zero()); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::Ignore> {
+    static constexpr uint32_t LO_C = RuleTableHalf(CARE, VARS, false);
+    static constexpr uint32_t HI_C = RuleTableHalf(CARE, VARS, true);
+    typedef RuleNetwork<Ops, (RuleTableHalf(TABLE, VARS, false) & LO_C) | (RuleTableHalf(TABLE, VARS, true) & HI_C),
+                        LO_C | HI_C, VARS - 1> Merged;
+    static typename Ops::V Eval(const typename Ops::V *vars) { return Merged::Eval(vars); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::Xor> {
+    static constexpr uint32_t LO_C = RuleTableHalf(CARE, VARS, false);
+    static constexpr uint32_t HI_C = RuleTableHalf(CARE, VARS, true);
+    // v = 1 时的结果是 Lo 取反，把 Hi 取反后与 Lo 合并成一张子表
+    typedef RuleNetwork<Ops, (RuleTableHalf(TABLE, VARS, false) & LO_C) | (~RuleTableHalf(TABLE, VARS, true) & HI_C),
+                        LO_C | HI_C, VARS - 1> Merged;
+    static typename Ops::V Eval(const typename Ops::V *vars) { return Ops::Xor(vars[VARS - 1], Merged::Eval(vars)); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::AndNot> {
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, false), RuleTableHalf(CARE, VARS, false), VARS - 1> Lo;
+    static typename Ops::V Eval(const typename Ops::V *vars) {
+        return Ops::And(Ops::Not(vars[VARS - 1]), Lo::Eval(vars));
+    }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::Or> {
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, false), RuleTableHalf(CARE, VARS, false), VARS - 1> Lo;
+    static typename Ops::V Eval(const typename Ops::V *vars) { return Ops::Or(vars[VARS - 1], Lo::Eval(vars)); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::And> {
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, true), RuleTableHalf(CARE, VARS, true), VARS - 1> Hi;
+    static typename Ops::V Eval(const typename Ops::V *vars) { return Ops::And(vars[VARS - 1], Hi::Eval(vars)); }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::OrNot> {
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, true), RuleTableHalf(CARE, VARS, true), VARS - 1> Hi;
+    static typename Ops::V Eval(const typename Ops::V *vars) {
+        return Ops::Or(Ops::Not(vars[VARS - 1]), Hi::Eval(vars));
+    }
+};
+
+template <class Ops, uint32_t TABLE, uint32_t CARE, int VARS>
+struct RuleNetwork<Ops, TABLE, CARE, VARS, RuleNodeKind::Select> {
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, false), RuleTableHalf(CARE, VARS, false), VARS - 1> Lo;
+    typedef RuleNetwork<Ops, RuleTableHalf(TABLE, VARS, true), RuleTableHalf(CARE, VARS, true), VARS - 1> Hi;
+    static typename Ops::V Eval(const typename Ops::V *vars) {
+        const typename Ops::V v = vars[VARS - 1];
+        return Ops::Or(Ops::And(v, Hi::Eval(vars)), Ops::And(Ops::Not(v), Lo::Eval(vars)));
+    }
+};
+
+/**
+ * @brief 把 B/S 规则作用于和位平面
+ *
+ * 对转移掩码中的每个 n，构造 "邻居数 == n" 的位平面并累加。
+ * 邻居数最大为 8 (二进制 1000)，因此只有 n = 0 和 n = 8 需要检查 s3。
+ * 用于 RuntimeRule；StaticRule 由下面的特化改用 RuleNetwork。
+ */
+template <class Ops, class Rule>
+struct RuleApplier {
+    static typename Ops::V Apply(typename Ops::V s0, typename Ops::V s1, typename Ops::V s2, typename Ops::V s3,
+                                 typename Ops::V alive, const Rule &rule) {
+        const uint16_t birth = rule.birth;
+        const uint16_t survival = rule.survival;
+        typename Ops::V born = Ops::Zero();
+        typename Ops::V survive = Ops::Zero();
+        for (int n = 0; n <= 8; ++n) {
+            const uint16_t bit = static_cast<uint16_t>(1u << n);
+            if (!((birth | survival) & bit)) continue;
+
+            typename Ops::V eq;
+            if (n == 8) {
+                eq = s3;
+            } else {
+                eq = Ops::And(Ops::And((n & 1) ? s0 : Ops::Not(s0), (n & 2) ? s1 : Ops::Not(s1)),
+                              (n & 4) ? s2 : Ops::Not(s2));
+                if (n == 0) eq = Ops::And(eq, Ops::Not(s3));
+            }
+            if (birth & bit) born = Ops::Or(born, eq);
+            if (survival & bit) survive = Ops::Or(survive, eq);
+        }
+        return Ops::Or(Ops::And(alive, survive), Ops::And(Ops::Not(alive), born));
+    }
+};
+
+/**
+ * @brief 编译期规则：直接求值展开好的布尔网络
+ */
+template <class Ops, uint16_t BIRTH, uint16_t SURVIVAL>
+struct RuleApplier<Ops, StaticRule<BIRTH, SURVIVAL> > {
+    static typename Ops::V Apply(typename Ops::V s0, typename Ops::V s1, typename Ops::V s2, typename Ops::V s3,
+                                 typename Ops::V alive, const StaticRule<BIRTH, SURVIVAL> &) {
+        const typename Ops::V vars[5] = {alive, s0, s1, s2, s3};
+        return RuleNetwork<Ops, StaticRuleTruthTable(BIRTH, SURVIVAL), STATIC_RULE_CARE, 5>::Eval(vars);
+    }
+};
+
+/**
+ * @brief 把规则作用于和位平面，返回下一代 (Rule 为 RuntimeRule 或 StaticRule)
+ */
+template <class Ops, class Rule>
+inline typename Ops::V ApplyRule(typename Ops::V s0, typename Ops::V s1, typename Ops::V s2, typename Ops::V s3,
+                                 typename Ops::V alive, const Rule &rule) {
+    return RuleApplier<Ops, Rule>::Apply(s0, s1, s2, s3, alive, rule);
+}
+
+/**
+ * @brief 对邻域网络按位并行求值
+ *
+ * planes[k] 为邻域下标第 k 位对应的邻居平面 (位布局见 CompiledRule)。
+ * 每个节点是一个选择 low ^ (v & (low ^ high))，按子节点在前的顺序依次求值。
+ */
+template <class Ops>
+inline typename Ops::V EvalNeighborhoodNetwork(const typename Ops::V planes[9], const NeighborhoodNetwork &network) {
+    typename Ops::V values[2 + NeighborhoodNetwork::MAX_NODES];
+    values[0] = Ops::Zero();
+    values[1] = Ops::Not(Ops::Zero());
+    for (int k = 0; k < network.nodeCount; ++k) {
+        const NeighborhoodNode &node = network.nodes[k];
+        const typename Ops::V low = values[node.low];
+        values[k + 2] = Ops::Xor(low, Ops::And(planes[node.var], Ops::Xor(low, values[node.high])));
+    }
+    return values[network.output];
+}
+
+/**
+ * @brief 计算一行中 [firstWord, lastWord) 范围内各字的下一代 (标量)
+ *
+ * 第 0 列的西邻居与第 width-1 列的东邻居取自幽灵细胞，边界拓扑对内核透明。
+ * 幽灵细胞只影响每行首尾两个字，SIMD 路径用它处理行首、行尾与不足一个向量的余数。
+ * 本函数不清除填充位，由调用方负责。
+ *
+ * @param above 上一行 (首行时为幽灵行)
+ * @param row 当前行
+ * @param below 下一行 (末行时为幽灵行)
+ * @param out 输出行
+ * @param firstWord 起始字下标
+ * @param lastWord 结束字下标 (不含)
+ * @param wordsPerRow 每行有效字数
+ * @param width 网格宽度 (细胞)
+ * @param ghosts 本行左右两侧的幽灵细胞
+ * @param rule 预编译规则
+ */
+void StepWordsSwar(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                   int firstWord, int lastWord, int wordsPerRow, int width, GhostCells ghosts,
+                   const CompiledRule &rule);
+
+/**
+ * @brief 计算一行中 [firstWord, lastWord) 范围内的下一代 (标量实现)
+ *
+ * 与 StepWordsSwar 相同，但范围包含最后一个字时会清除填充位。
+ * @param lastWordMask 最后一个字的有效位掩码，用于清除填充位
+ */
+void StepRowSwar(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                 int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                 GhostCells ghosts, const CompiledRule &rule);
+
+/**
+ * @brief 计算一行中 [firstWord, lastWord) 范围内各字的下一代 (512 项邻域表，标量)
+ *
+ * 用于非全和规则。rule.network 已生成时按字对邻域网络求值 (64 个细胞一起)；
+ * 否则每个细胞由上中下三行各 3 位拼出 9 位邻域下标 (位布局见 CompiledRule)，再查 rule.neighborhood 中的一位。
+ * 与 StepWordsSwar 一样不清除填充位，SIMD 路径用它处理行首、行尾与余数。
+ */
+void StepWordsLut(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                  int firstWord, int lastWord, int wordsPerRow, int width, GhostCells ghosts,
+                  const CompiledRule &rule);
+
+/**
+ * @brief 计算一行中 [firstWord, lastWord) 范围内的下一代 (512 项邻域表，标量实现)
+ *
+ * 与 StepWordsLut 相同，参数与清除填充位的行为同 StepRowSwar。
+ */
+void StepRowLut(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                GhostCells ghosts, const CompiledRule &rule);
+
+/**
+ * @brief Generations 规则的衰减处理 (一行中 [firstWord, lastWord) 范围)
+ *
+ * 输入 nextAlive 是行内核按出生/存活掩码算出的下一代活细胞 (只统计状态 1 的邻居)，
+ * 这里再逐字节推进衰减态：
+ * - 衰减中的细胞 (状态 >= 2) 不能出生，状态加 1，到 stateCount 时归 0；
+ * - 不满足存活条件的活细胞进入状态 2；
+ * - nextAlive 被改写为最终的活细胞位平面 (与 nextStates 中的状态 1 一致)。
+ *
+ * @param states 当前代状态行
+ * @param nextStates 下一代状态行 (输出)
+ * @param nextAlive 下一代活细胞位平面行 (输入输出)
+ * @param stateCount 状态数 (大于 2)
+ * @return bool 该范围的状态是否发生变化
+ */
+bool ApplyDecayRow(const uint8_t *states, uint8_t *nextStates, uint64_t *nextAlive,
+                   int firstWord, int lastWord, int width, int stateCount);
@@ -0,0 +1,198 @@
+#include "LtlKernel.h"
+#include <algorithm>
+#include <cstdlib>
+#include "BitOps.h"
+#include "LifeKernel.h"
+#include "SimdKernel.h"
+
+LtlKernel::LtlKernel()
+    : m_radius(0), m_vonNeumann(false), m_margin(0), m_paddedWidth(0), m_paddedHeight(0) {
+}
+
+/**
+ * @brief 构建前缀和表
+ *
+ * 运行时的拓扑选择只在这里分派一次，与 BoundaryHalo::Refresh 相同。
+ */
+void LtlKernel::Prepare(BoundaryTopology topology, const BitGrid &src, const CompiledRule &rule) {
+    m_radius = rule.ltl.radius;
+    m_vonNeumann = rule.ltl.vonNeumann;
+    switch (topology) {
+        case BoundaryTopology::Torus: Build<TorusTopology>(src); return;
+        case BoundaryTopology::DeadEdge: Build<DeadEdgeTopology>(src); return;
+        case BoundaryTopology::KleinBottle: Build<KleinBottleTopology>(src); return;
+        case BoundaryTopology::CrossSurface: Build<CrossSurfaceTopology>(src); return;
+    }
+    Build<TorusTopology>(src);
+}
+
+unsigned long long LtlKernel::EstimateBytes(int width, int height, const LtlRule &rule) {
+    const unsigned long long margin = rule.radius + 1;
+    const unsigned long long padded = (width + 2 * margin) * (height + 2 * margin);
+    // 行前缀和，菱形邻域另加两张对角线前缀和
+    return padded * sizeof(uint16_t) * (rule.vonNeumann ? 3 : 1) + (width + 2 * margin);
+}
+
+template <class Topology>
+void LtlKernel::Build(const BitGrid &src) {
+    const int width = src.GetWidth();
+    const int height = src.GetHeight();
+    m_margin = m_radius + 1;
+    m_paddedWidth = width + 2 * m_margin;
+    m_paddedHeight = height + 2 * m_margin;
+    const size_t size = static_cast<size_t>(m_paddedWidth) * m_paddedHeight;
+    m_cells.resize(m_paddedWidth);
+    m_rowPrefix.resize(size);
+    if (m_vonNeumann) {
+        m_diagDown.resize(size);
+        m_diagUp.resize(size);
+    } else {
+        // 正方形邻域用不到对角线前缀和，释放内存
+        std::vector<uint16_t>().swap(m_diagDown);
+        std::vector<uint16_t>().swap(m_diagUp);
+    }
+
+    auto cell = [&](int x, int y) -> uint8_t {
+        if (x >= 0 && x < width && y >= 0 && y < height) return src.Get(x, y) ? 1 : 0;
+        if (!Topology::Map(x, y, width, height)) return 0;
+        return src.Get(x, y) ? 1 : 0;
+    };
+
+    for (int py = 0; py < m_paddedHeight; ++py) {
+        const int y = py - m_margin;
+        // 1. 展开一行带边细胞：网格内直接按字取位，外圈按拓扑映射
+        if (y >= 0 && y < height) {
+            const uint64_t *row = src.GetRow(y);
+            for (int px = 0; px < m_margin; ++px) {
+                m_cells[px] = cell(px - m_margin, y);
+                m_cells[m_margin + width + px] = cell(width + px, y);
+            }
+            for (int x = 0; x < width; ++x) {
+                m_cells[m_margin + x] = static_cast<uint8_t>((row[x >> 6] >> (x & 63)) & 1ULL);
+            }
+        } else {
+            for (int px = 0; px < m_paddedWidth; ++px) {
+                m_cells[px] = cell(px - m_margin, y);
+            }
+        }
+
+        // 2. 行前缀和
+        uint16_t *prefix = &m_rowPrefix[static_cast<size_t>(py) * m_paddedWidth];
+        uint16_t sum = 0;
+        for (int px = 0; px < m_paddedWidth; ++px) {
+            sum = static_cast<uint16_t>(sum + m_cells[px]);
+            prefix[px] = sum;
+        }
+
+        // 3. 对角线前缀和：沿对角线接上一行的值
+        if (m_vonNeumann) {
+            uint16_t *down = &m_diagDown[static_cast<size_t>(py) * m_paddedWidth];
+            uint16_t *up = &m_diagUp[static_cast<size_t>(py) * m_paddedWidth];
+            if (py == 0) {
+                for (int px = 0; px < m_paddedWidth; ++px) {
+                    down[px] = m_cells[px];
+                    up[px] = m_cells[px];
+                }
+            } else {
+                const uint16_t *prevDown = down - m_paddedWidth;
+                const uint16_t *prevUp = up - m_paddedWidth;
+                const int last = m_paddedWidth - 1;
+                down[0] = m_cells[0];
+                for (int px = 1; px <= last; ++px) {
+                    down[px] = static_cast<uint16_t>(prevDown[px - 1] + m_cells[px]);
+                }
+                for (int px = 0; px < last; ++px) {
+                    up[px] = static_cast<uint16_t>(prevUp[px + 1] + m_cells[px]);
+                }
+                up[last] = m_cells[last];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 直接求一个细胞的邻域计数 (含中心)，只用于分块首行
+ */
+int LtlKernel::CountNeighborhood(int x, int y) const {
+    const int r = m_radius;
+    int count = 0;
+    for (int dy = -r; dy <= r; ++dy) {
+        const int half = m_vonNeumann ? r - std::abs(dy) : r;
+        count += RowSum(y + dy, x - half, x + half);
+    }
+    return count;
+}
+
+/**
+ * @brief 计算一个分块的下一代
+ *
+ * counts 保存分块内每一列当前行的邻域计数 (含中心)，逐行向下滑动。
+ */
+bool LtlKernel::StepTile(const KernelTable &kernels, const BitGrid &src, BitGrid &dst, const StateGrid &srcStates, StateGrid &dstStates,
+                         int firstRow, int lastRow, int firstWord, int lastWord, const CompiledRule &rule,
+                         CellCounts *cellCounts) const {
+    const LtlRule &ltl = rule.ltl;
+    const int r = m_radius;
+    const int width = src.GetWidth();
+    const int x0 = firstWord * 64;
+    const int x1 = std::min(lastWord * 64, width);
+    if (cellCounts != nullptr) *cellCounts = CellCounts();
+    if (x0 >= x1) return false;
+
+    std::vector<int> counts(x1 - x0);
+    bool changed = false;
+    for (int y = firstRow; y < lastRow; ++y) {
+        // 1. 邻域计数
+        if (y == firstRow) {
+            for (int x = x0; x < x1; ++x) {
+                counts[x - x0] = CountNeighborhood(x, y);
+            }
+        } else if (!m_vonNeumann) {
+            // 正方形：进入第 y+R 行，离开第 y-1-R 行
+            for (int x = x0; x < x1; ++x) {
+                counts[x - x0] += RowSum(y + r, x - r, x + r) - RowSum(y - 1 - r, x - r, x + r);
+            }
+        } else {
+            // 菱形：中心从 (x, c) 移到 (x, c+1) 时，进入下方 "V" 形的两段对角线，离开上方 "^" 形的两段
+            const int c = y - 1;
+            for (int x = x0; x < x1; ++x) {
+                const int enter = static_cast<uint16_t>(DiagDown(x, c + 1 + r) - DiagDown(x - r - 1, c)) +
+                                  static_cast<uint16_t>(DiagUp(x + 1, c + r) - DiagUp(x + r + 1, c));
+                const int leave = static_cast<uint16_t>(DiagUp(x - r, c) - DiagUp(x + 1, c - r - 1)) +
+                                  static_cast<uint16_t>(DiagDown(x + r, c) - DiagDown(x, c - r));
+                counts[x - x0] += enter - leave;
+            }
+        }
+
+        // 2. 按区间求值并打包成字
+        const uint64_t *in = src.GetRow(y);
+        uint64_t *out = dst.GetRow(y);
+        for (int w = firstWord; w < lastWord; ++w) {
+            const int base = w * 64;
+            const int count = std::min(64, x1 - base);
+            const uint64_t word = in[w];
+            uint64_t next = 0;
+            for (int j = 0; j < count; ++j) {
+                const int alive = static_cast<int>((word >> j) & 1ULL);
+                const int n = counts[base + j - x0] - (ltl.countCenter ? 0 : alive);
+                const bool on = alive ? (n >= ltl.survivalMin && n <= ltl.survivalMax)
+                                      : (n >= ltl.birthMin && n <= ltl.birthMax);
+                next |= static_cast<uint64_t>(on) << j;
+            }
+            out[w] = next;
+            if (!rule.IsGenerations() && next != word) changed = true;
+        }
+
+        // 3. Generations 规则的衰减态
+        if (rule.IsGenerations() &&
+            ApplyDecayRow(srcStates.GetRow(y), dstStates.GetRow(y), out, firstWord, lastWord, width, rule.states)) {
+            changed = true;
+        }
+
+        // 4. 细胞计数 (本行刚写完，仍在缓存中)
+        if (cellCounts != nullptr) {
+            kernels.accumulateCounts(in + firstWord, out + firstWord, lastWord - firstWord, *cellCounts);
+        }
+    }
+    return changed;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BitGrid.h"
+#include "StateGrid.h"
+#include "Topology.h"
+#include "CompiledRule.h"
+
+struct CellCounts;
+struct KernelTable;
+
+/**
+ * @brief Larger than Life 演化内核
+ *
+ * 半径 R 的邻域有 (2R+1)^2 个细胞，逐个累加在 R = 10 时每个细胞要读 441 次。
+ * 这里改用前缀和，使每个细胞的代价与半径无关：
+ *
+ * 1. Prepare：每代一次，把网格连同外圈 R+1 个细胞 (按边界拓扑取值) 展开成带边的平面，
+ *    并求出 行前缀和 (正方形邻域) 或 行前缀和 + 两个对角线前缀和 (菱形邻域)；
+ * 2. StepTile：分块的首行用行前缀和直接求出每列的邻域计数 (O(R))，
+ *    之后每下移一行只需要加上新进入的一条边、减去离开的一条边：
+ *    - 正方形邻域的边是一段行，由行前缀和 O(1) 求出；
+ *    - 菱形邻域的边是两段对角线 ("V" 形进入，"^" 形离开)，由对角线前缀和 O(1) 求出。
+ *
+ * 前缀和按 16 位无符号数存储并允许回绕：需要的只是两项之差 (不超过 441)，模 65536 的差仍然精确，
+ * 因此表的大小只有 int 的一半，也不受网格尺寸限制。
+ *
+ * 只有活细胞 (位平面中的 1) 计入邻居，因此 Generations 形式的 LtL 规则 (C 大于 2) 也能直接使用，
+ * 衰减态由 ApplyDecayRow 统一处理。
+ */
+class LtlKernel {
+public:
+    LtlKernel();
+
+    /**
+     * @brief 为当前代构建前缀和表
+     *
+     * 表的尺寸随网格与半径自动调整，之后各分块可以在任意线程上并行调用 StepTile。
+     * @param topology 边界拓扑 (决定带边平面外圈的取值)
+     * @param src 当前代网格
+     * @param rule LtL 规则 (rule.IsLargerThanLife() 必须为 true)
+     */
+    void Prepare(BoundaryTopology topology, const BitGrid &src, const CompiledRule &rule);
+
+    /**
+     * @brief 估算 width x height 网格在该规则下前缀和表占用的字节数 (用于内存预算检查)
+     */
+    static unsigned long long EstimateBytes(int width, int height, const LtlRule &rule);
+
+    /**
+     * @brief 计算一个矩形分块 (行 [firstRow, lastRow) x 字 [firstWord, lastWord)) 的下一代
+     *
+     * 只读 src 与前缀和表、只写 dst 中这块区域，互不重叠的分块可以并行计算。
+     * Generations 规则下同时推进状态平面 (两态规则时 srcStates/dstStates 不被访问)。
+     * @param kernels 细胞计数使用的函数表
+     * @param cellCounts 非空时统计该区域下一代的活细胞数与出生/死亡数
+     * @return bool 该区域的下一代是否与当前代不同
+     */
+    bool StepTile(const KernelTable &kernels, const BitGrid &src, BitGrid &dst, const StateGrid &srcStates, StateGrid &dstStates,
+                  int firstRow, int lastRow, int firstWord, int lastWord, const CompiledRule &rule,
+                  CellCounts *cellCounts = nullptr) const;
+
+private:
+    template <class Topology>
+    void Build(const BitGrid &src);
+
+    /**
+     * @brief 带边平面中一行的 [x0, x1] 段之和 (网格坐标，含两端)
+     */
+    int RowSum(int y, int x0, int x1) const {
+        const uint16_t *row = &m_rowPrefix[static_cast<size_t>(y + m_margin) * m_paddedWidth + m_margin];
+        return static_cast<uint16_t>(row[x1] - row[x0 - 1]);
+    }
+
+    /**
+     * @brief 左上到右下方向的对角线前缀和 (网格坐标)
+     */
+    int DiagDown(int x, int y) const {
+        return m_diagDown[static_cast<size_t>(y + m_margin) * m_paddedWidth + x + m_margin];
+    }
+
+    /**
+     * @brief 右上到左下方向的对角线前缀和 (网格坐标)
+     */
+    int DiagUp(int x, int y) const {
+        return m_diagUp[static_cast<size_t>(y + m_margin) * m_paddedWidth + x + m_margin];
+    }
+
+    int CountNeighborhood(int x, int y) const;
+
+    int m_radius; ///< 当前表对应的半径
+    bool m_vonNeumann; ///< 当前表是否包含对角线前缀和
+    int m_margin; ///< 带边平面每侧多出的细胞数 (R + 1)
+    int m_paddedWidth; ///< 带边平面宽度
+    int m_paddedHeight; ///< 带边平面高度
+    std::vector<uint8_t> m_cells; ///< 构建时使用的一行带边细胞
+    std::vector<uint16_t> m_rowPrefix; ///< 行前缀和 (含本列)
+    std::vector<uint16_t> m_diagDown; ///< 沿左上到右下方向累加的前缀和 (含本格)
+    std::vector<uint16_t> m_diagUp; ///< 沿右上到左下方向累加的前缀和 (含本格)
+};
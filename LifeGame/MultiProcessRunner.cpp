@@ -0,0 +1,397 @@
+#include "MultiProcessRunner.h"
+#include "TemporalBlocker.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#if defined(__linux__)
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+constexpr int MultiProcessRunner::MAX_PROCESSES;
+
+MultiProcessRunner::MultiProcessRunner() : m_lastElapsedMs(0.0), m_lastProcessCount(0) {
+}
+
+bool MultiProcessRunner::IsSupported(BoundaryTopology topology, const CompiledRule &rule) {
+    return TemporalBlocker::IsSupported(topology, rule);
+}
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && ATOMIC_INT_LOCK_FREE == 2,
+              "futex 需要与 uint32_t 布局相同的无锁原子量");
+
+static constexpr size_t SHARED_LINE_BYTES = 64; ///< 共享内存中各控制块的对齐 (避免伪共享)
+
+/**
+ * @brief 共享内存头部
+ */
+struct SharedHeader {
+    std::atomic<uint32_t> start; ///< 协调进程置 1 后工作进程开始演化 (futex 字)
+    std::atomic<uint32_t> aborted; ///< 有进程异常退出时置 1，其余进程停止等待
+    std::atomic<uint32_t> finished; ///< 已写回结果的工作进程数 (futex 字)
+};
+
+/**
+ * @brief Halo 环形缓冲的控制块 (其后紧跟 HALO_RING_SLOTS 行数据)
+ *
+ * 只有一个生产者 (条块所属进程) 和一个消费者 (相邻进程)。
+ */
+struct HaloRing {
+    std::atomic<uint32_t> published; ///< 已发布的代数，第 g 代的行在第 g % HALO_RING_SLOTS 格 (futex 字)
+    std::atomic<uint32_t> sleeping; ///< 消费者是否正在 futex 上睡眠
+};
+
+/**
+ * @brief 工作进程所需的全部参数 (fork 时随地址空间复制)
+ */
+struct WorkerContext {
+    unsigned char *base; ///< 共享内存首地址
+    size_t ringBytes; ///< 单个环形缓冲 (控制块 + 数据) 的字节数
+    size_t gridOffset; ///< 共享网格在共享内存中的偏移
+    int processCount;
+    int width;
+    int height;
+    int wordsPerRow;
+    int stride;
+    uint64_t lastWordMask;
+    int generations;
+    BoundaryTopology topology;
+    StepRowFn stepRow;
+    const CompiledRule *rule;
+};
+
+static size_t AlignUp(size_t bytes, size_t align) {
+    return (bytes + align - 1) / align * align;
+}
+
+static long FutexWait(std::atomic<uint32_t> &word, uint32_t expected, const timespec *timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+static void FutexWake(std::atomic<uint32_t> &word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+static SharedHeader &Header(const WorkerContext &ctx) {
+    return *reinterpret_cast<SharedHeader *>(ctx.base);
+}
+
+/**
+ * @brief 第 index 个进程的环形缓冲 (down 为 true 时是末行，供下邻居读取；否则是首行，供上邻居读取)
+ */
+static HaloRing &Ring(const WorkerContext &ctx, int index, bool down) {
+    return *reinterpret_cast<HaloRing *>(ctx.base + SHARED_LINE_BYTES + (2 * index + (down ? 1 : 0)) * ctx.ringBytes);
+}
+
+static uint64_t *RingSlot(const WorkerContext &ctx, HaloRing &ring, int generation) {
+    unsigned char *data = reinterpret_cast<unsigned char *>(&ring) + SHARED_LINE_BYTES;
+    return reinterpret_cast<uint64_t *>(data) +
+           static_cast<size_t>(generation % MultiProcessRunner::HALO_RING_SLOTS) * ctx.stride;
+}
+
+static uint64_t *SharedRow(const WorkerContext &ctx, int y) {
+    return reinterpret_cast<uint64_t *>(ctx.base + ctx.gridOffset) + static_cast<size_t>(y) * ctx.stride;
+}
+
+static int SlabFirstRow(const WorkerContext &ctx, int index) {
+    return static_cast<int>(static_cast<long long>(ctx.height) * index / ctx.processCount);
+}
+
+/**
+ * @brief 发布第 generation 代的一行，对方正在睡眠时才唤醒
+ */
+static void Publish(const WorkerContext &ctx, HaloRing &ring, int generation, const uint64_t *row) {
+    memcpy(RingSlot(ctx, ring, generation), row, ctx.stride * sizeof(uint64_t));
+    ring.published.store(static_cast<uint32_t>(generation + 1));
+    if (ring.sleeping.exchange(0)) FutexWake(ring.published);
+}
+
+/**
+ * @brief 等待邻居发布第 generation 代的行
+ *
+ * 先自旋，仍未就绪时登记睡眠标记并再次检查，然后在序号上 futex 睡眠 (带超时，以便发现异常中止)。
+ * @return bool 其他进程已异常退出时返回 false
+ */
+static bool WaitPublished(const WorkerContext &ctx, HaloRing &ring, int generation) {
+    const uint32_t target = static_cast<uint32_t>(generation + 1);
+    for (int spin = 0; spin < MultiProcessRunner::SPIN_ITERATIONS; ++spin) {
+        if (ring.published.load(std::memory_order_acquire) >= target) return true;
+    }
+    const timespec timeout = {0, 100 * 1000 * 1000};
+    for (;;) {
+        const uint32_t seen = ring.published.load();
+        if (seen >= target) return true;
+        if (Header(ctx).aborted.load()) return false;
+        ring.sleeping.store(1);
+        if (ring.published.load() >= target) {
+            ring.sleeping.store(0);
+            return true;
+        }
+        FutexWait(ring.published, seen, &timeout);
+    }
+}
+
+/**
+ * @brief 把邻居的行取入本地 Halo 行 (克莱因瓶越过上下边界时左右翻转)
+ */
+static void FetchHalo(const WorkerContext &ctx, const uint64_t *src, uint64_t *out, bool mirrored) {
+    if (!mirrored) {
+        memcpy(out, src, ctx.stride * sizeof(uint64_t));
+        return;
+    }
+    memset(out, 0, ctx.stride * sizeof(uint64_t));
+    for (int x = 0; x < ctx.width; ++x) {
+        if ((src[x >> 6] >> (x & 63)) & 1ULL) out[(ctx.width - 1 - x) >> 6] |= 1ULL << ((ctx.width - 1 - x) & 63);
+    }
+}
+
+static uint8_t CellBit(const uint64_t *row, int x) {
+    return static_cast<uint8_t>((row[x >> 6] >> (x & 63)) & 1ULL);
+}
+
+/**
+ * @brief 工作进程主体
+ *
+ * 本地第 0 行与第 rows + 1 行是上下 Halo，第 1 .. rows 行是本进程的条块。
+ * @return int 进程退出码 (0 为成功)
+ */
+static int RunWorker(const WorkerContext &ctx, int index) {
+    const int firstRow = SlabFirstRow(ctx, index);
+    const int rows = SlabFirstRow(ctx, index + 1) - firstRow;
+    const int last = ctx.processCount - 1;
+    const bool firstSlab = index == 0;
+    const bool lastSlab = index == last;
+    const bool deadEdge = ctx.topology == BoundaryTopology::DeadEdge;
+    const bool mirrorEdge = ctx.topology == BoundaryTopology::KleinBottle;
+
+    HaloRing &upRing = Ring(ctx, index, false);
+    HaloRing &downRing = Ring(ctx, index, true);
+    // 上邻居的末行是本地第 0 行，下邻居的首行是本地第 rows + 1 行
+    HaloRing &aboveRing = Ring(ctx, firstSlab ? last : index - 1, true);
+    HaloRing &belowRing = Ring(ctx, lastSlab ? 0 : index + 1, false);
+
+    BitGrid front(ctx.width, rows + 2);
+    BitGrid back(ctx.width, rows + 2);
+    for (int i = 0; i < rows; ++i) {
+        memcpy(front.GetRow(i + 1), SharedRow(ctx, firstRow + i), ctx.stride * sizeof(uint64_t));
+    }
+
+    // 等待协调进程放行 (所有进程就绪后同时开始计时)
+    while (Header(ctx).start.load() == 0) {
+        FutexWait(Header(ctx).start, 0, nullptr);
+    }
+
+    const bool wrapColumns = !deadEdge;
+    for (int g = 0; g < ctx.generations; ++g) {
+        Publish(ctx, upRing, g, front.GetRow(1));
+        Publish(ctx, downRing, g, front.GetRow(rows));
+
+        if (firstSlab && deadEdge) {
+            memset(front.GetRow(0), 0, ctx.stride * sizeof(uint64_t));
+        } else {
+            if (!WaitPublished(ctx, aboveRing, g)) return 1;
+            FetchHalo(ctx, RingSlot(ctx, aboveRing, g), front.GetRow(0), firstSlab && mirrorEdge);
+        }
+        if (lastSlab && deadEdge) {
+            memset(front.GetRow(rows + 1), 0, ctx.stride * sizeof(uint64_t));
+        } else {
+            if (!WaitPublished(ctx, belowRing, g)) return 1;
+            FetchHalo(ctx, RingSlot(ctx, belowRing, g), front.GetRow(rows + 1), lastSlab && mirrorEdge);
+        }
+
+        for (int i = 1; i <= rows; ++i) {
+            const uint64_t *above = front.GetRow(i - 1);
+            const uint64_t *row = front.GetRow(i);
+            const uint64_t *below = front.GetRow(i + 1);
+            GhostCells ghosts = {0, 0};
+            if (wrapColumns) {
+                const int east = ctx.width - 1;
+                ghosts.west = static_cast<uint8_t>(CellBit(above, east) | (CellBit(row, east) << 1) |
+                                                   (CellBit(below, east) << 2));
+                ghosts.east = static_cast<uint8_t>(CellBit(above, 0) | (CellBit(row, 0) << 1) |
+                                                   (CellBit(below, 0) << 2));
+            }
+            ctx.stepRow(above, row, below, back.GetRow(i), 0, ctx.wordsPerRow, ctx.wordsPerRow, ctx.width,
+                        ctx.lastWordMask, ghosts, *ctx.rule);
+        }
+        front.Swap(back);
+    }
+
+    for (int i = 0; i < rows; ++i) {
+        memcpy(SharedRow(ctx, firstRow + i), front.GetRow(i + 1), ctx.stride * sizeof(uint64_t));
+    }
+    Header(ctx).finished.fetch_add(1);
+    FutexWake(Header(ctx).finished);
+    return 0;
+}
+
+/**
+ * @brief 中止所有工作进程：置中止标记并唤醒所有可能在睡眠的进程
+ */
+static void AbortWorkers(const WorkerContext &ctx) {
+    Header(ctx).aborted.store(1);
+    Header(ctx).start.store(1);
+    FutexWake(Header(ctx).start);
+    for (int i = 0; i < ctx.processCount; ++i) {
+        FutexWake(Ring(ctx, i, false).published);
+        FutexWake(Ring(ctx, i, true).published);
+    }
+}
+
+bool MultiProcessRunner::IsAvailable() {
+    return true;
+}
+
+bool MultiProcessRunner::Run(StepRowFn stepRow, BoundaryTopology topology, BitGrid &grid, int processCount,
+                             int generations, const CompiledRule &rule) {
+    m_lastElapsedMs = 0.0;
+    m_lastError.clear();
+    processCount = std::max(1, std::min(std::min(processCount, MAX_PROCESSES), grid.GetHeight()));
+    m_lastProcessCount = processCount;
+    if (!IsSupported(topology, rule)) {
+        m_lastError = "rule or topology cannot be split into slabs";
+        return false;
+    }
+    if (generations <= 0) return true;
+
+    WorkerContext ctx;
+    ctx.processCount = processCount;
+    ctx.width = grid.GetWidth();
+    ctx.height = grid.GetHeight();
+    ctx.wordsPerRow = grid.GetWordsPerRow();
+    ctx.stride = grid.GetStride();
+    ctx.lastWordMask = grid.GetLastWordMask();
+    ctx.generations = generations;
+    ctx.topology = topology;
+    ctx.stepRow = stepRow;
+    ctx.rule = &rule;
+
+    // 1. 共享内存布局：头部 | 2 * processCount 个环形缓冲 | 网格
+    const size_t rowBytes = static_cast<size_t>(ctx.stride) * sizeof(uint64_t);
+    ctx.ringBytes = AlignUp(SHARED_LINE_BYTES + HALO_RING_SLOTS * rowBytes, SHARED_LINE_BYTES);
+    ctx.gridOffset = SHARED_LINE_BYTES + 2 * static_cast<size_t>(processCount) * ctx.ringBytes;
+    const size_t totalBytes = ctx.gridOffset + rowBytes * ctx.height;
+
+    static std::atomic<unsigned> s_segmentCounter(0);
+    char name[64];
+    snprintf(name, sizeof(name), "/lifegame-%d-%u", static_cast<int>(getpid()), s_segmentCounter++);
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        m_lastError = std::string("shm_open failed: ") + strerror(errno);
+        return false;
+    }
+    // 子进程通过 fork 继承映射，名字立即删除，进程退出后内存自动回收
+    shm_unlink(name);
+    if (ftruncate(fd, static_cast<off_t>(totalBytes)) != 0) {
+        m_lastError = std::string("ftruncate failed: ") + strerror(errno);
+        close(fd);
+        return false;
+    }
+    void *mapped = mmap(nullptr, totalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        m_lastError = std::string("mmap failed: ") + strerror(errno);
+        return false;
+    }
+    ctx.base = static_cast<unsigned char *>(mapped);
+
+    new(ctx.base) SharedHeader{{0}, {0}, {0}};
+    for (int i = 0; i < 2 * processCount; ++i) {
+        new(ctx.base + SHARED_LINE_BYTES + i * ctx.ringBytes) HaloRing{{0}, {0}};
+    }
+    for (int y = 0; y < ctx.height; ++y) {
+        memcpy(SharedRow(ctx, y), grid.GetRow(y), rowBytes);
+    }
+
+    // 2. 创建工作进程
+    std::vector<pid_t> workers;
+    bool ok = true;
+    for (int i = 0; i < processCount; ++i) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            // 子进程不返回调用者，也不执行父进程的析构与 atexit
+            _exit(RunWorker(ctx, i));
+        }
+        if (pid < 0) {
+            m_lastError = std::string("fork failed: ") + strerror(errno);
+            ok = false;
+            AbortWorkers(ctx);
+            break;
+        }
+        workers.push_back(pid);
+    }
+
+    // 3. 同时放行，等待全部写回结果 (计时到此为止)，再回收进程
+    // 按顺序 waitpid 会卡在等待已死邻居的进程上，因此轮询所有进程，其间在完成计数上限时睡眠
+    const auto start = std::chrono::steady_clock::now();
+    auto end = start;
+    if (ok) {
+        Header(ctx).start.store(1);
+        FutexWake(Header(ctx).start);
+    }
+    const timespec pollInterval = {0, 10 * 1000 * 1000};
+    bool timed = false;
+    size_t remaining = workers.size();
+    while (remaining > 0) {
+        const uint32_t finished = Header(ctx).finished.load();
+        if (!timed && finished == static_cast<uint32_t>(processCount)) {
+            end = std::chrono::steady_clock::now();
+            timed = true;
+        }
+        for (pid_t &pid: workers) {
+            if (pid <= 0) continue;
+            int status = 0;
+            const pid_t result = waitpid(pid, &status, WNOHANG);
+            if (result == 0 || (result < 0 && errno == EINTR)) continue;
+            if (result < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                if (ok) m_lastError = "worker process exited abnormally";
+                ok = false;
+                AbortWorkers(ctx);
+            }
+            pid = 0;
+            remaining--;
+        }
+        if (remaining > 0 && (timed || Header(ctx).finished.load() == finished)) {
+            FutexWait(Header(ctx).finished, finished, &pollInterval);
+        }
+    }
+    if (!timed) end = std::chrono::steady_clock::now();
+    m_lastElapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // 4. 读回结果
+    if (ok) {
+        for (int y = 0; y < ctx.height; ++y) {
+            memcpy(grid.GetRow(y), SharedRow(ctx, y), rowBytes);
+        }
+    }
+    munmap(mapped, totalBytes);
+    return ok;
+}
+
+#else
+
+bool MultiProcessRunner::IsAvailable() {
+    return false;
+}
+
+bool MultiProcessRunner::Run(StepRowFn, BoundaryTopology, BitGrid &, int, int, const CompiledRule &) {
+    m_lastElapsedMs = 0.0;
+    m_lastProcessCount = 0;
+    m_lastError = "multi-process mode needs POSIX shared memory and futex (Linux only)";
+    return false;
+}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include "BitGrid.h"
+#include "SimdKernel.h"
+#include "Topology.h"
+
+/**
+ * @brief 多进程域分解 (Domain Decomposition) 演化器
+ *
+ * 把一个网格按行切成若干横向条块 (Slab)，每个本地进程负责一块，条块横跨整行。
+ * 每一代各进程只需与上下两个邻居交换一行 Halo：
+ *
+ *   - 协调进程创建一段 POSIX 共享内存 (shm_open + mmap)，放入整个网格与每个进程的两个 Halo 环形缓冲，
+ *     然后 fork 出各工作进程；
+ *   - 工作进程每代先把首行、末行发布到自己的环形缓冲 (递增序号)，再等待邻居发布同一代的行，
+ *     等待先自旋片刻，仍未就绪再用 futex 睡眠，发布方只在对方睡眠时才唤醒；
+ *   - 推进完所有代后各进程把条块写回共享网格，协调进程等待全部退出后读回结果。
+ *
+ * 相邻进程互相依赖，进度最多相差一代，因此环形缓冲只需两格即可保证不被覆盖 (这里留有余量)。
+ * 上下边界按拓扑处理：环面首尾进程互为邻居，克莱因瓶在此基础上把越界的行左右翻转，有界平面边界外为 0。
+ * 支持的拓扑与规则与时间分块相同 (两态 3x3 规则，不含交叉帽)。
+ *
+ * 依赖 POSIX 共享内存与 Linux futex，只在 Linux 上可用；其他平台 IsAvailable 返回 false。
+ */
+class MultiProcessRunner {
+public:
+    static constexpr int MAX_PROCESSES = 256; ///< 允许的最大进程数
+    static constexpr int HALO_RING_SLOTS = 4; ///< 每个 Halo 环形缓冲的格数 (至少为 2)
+    static constexpr int SPIN_ITERATIONS = 4096; ///< 等待邻居时进入 futex 睡眠前的自旋次数
+
+    MultiProcessRunner();
+
+    /**
+     * @brief 当前平台是否支持多进程演化
+     */
+    static bool IsAvailable();
+
+    /**
+     * @brief 当前拓扑与规则能否按条块分解
+     */
+    static bool IsSupported(BoundaryTopology topology, const CompiledRule &rule);
+
+    /**
+     * @brief 用 processCount 个进程把 grid 推进 generations 代
+     *
+     * 结果与单进程逐代演化逐位一致。进程数会被限制为不超过网格行数与 MAX_PROCESSES。
+     * @param stepRow 行内核 (在 fork 之前选好，工作进程直接沿用)
+     * @param topology 边界拓扑 (IsSupported 必须为 true)
+     * @param grid 当前代网格，成功时返回推进后的网格，失败时保持不变
+     * @param processCount 工作进程数
+     * @param generations 推进的代数
+     * @param rule 预编译规则
+     * @return bool 共享内存创建失败、fork 失败或工作进程异常退出时返回 false (见 GetLastError)
+     */
+    bool Run(StepRowFn stepRow, BoundaryTopology topology, BitGrid &grid, int processCount, int generations,
+             const CompiledRule &rule);
+
+    /**
+     * @brief 最近一次 Run 的演化耗时 (毫秒，从放行工作进程到全部退出，不含创建共享内存与 fork)
+     */
+    double GetLastElapsedMs() const { return m_lastElapsedMs; }
+
+    /**
+     * @brief 最近一次 Run 实际使用的进程数
+     */
+    int GetLastProcessCount() const { return m_lastProcessCount; }
+
+    /**
+     * @brief 最近一次失败的原因
+     */
+    const std::string &GetLastError() const { return m_lastError; }
+
+private:
+    double m_lastElapsedMs; ///< 最近一次演化耗时
+    int m_lastProcessCount; ///< 最近一次使用的进程数
+    std::string m_lastError; ///< 最近一次失败的原因
+};
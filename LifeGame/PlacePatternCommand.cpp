@@ -8,15 +8,8 @@ PlacePatternCommand::PlacePatternCommand(int x, int y, int patternIndex, const L
     if (pattern) {
         // 保存图案覆盖区域内的所有细胞状态 (Bounding Box Area)
         // 这样撤销时可以精确恢复，而不需要备份整个网格
-        for (int dy = 0; dy < pattern->height; ++dy) {
-            for (int dx = 0; dx < pattern->width; ++dx) {
-                int cx = m_x + dx;
-                int cy = m_y + dy;
-                // 注意：GetCell 会处理边界检查
-                bool state = game.GetCell(cx, cy);
-                m_affectedCells.push_back({cx, cy, state});
-            }
-        }
+        // 快照本身也是位平面，每个细胞只占 1 bit，超出网格的部分按死细胞记录
+        game.GetGrid().ExtractRegion(m_x, m_y, pattern->width, pattern->height, m_backup);
     }
 }
 
@@ -25,9 +18,7 @@ void PlacePatternCommand::Execute(LifeGame &game) {
     game.PlacePattern(m_x, m_y, m_patternIndex);
 }
 
-// 撤销：逐个恢复受影响细胞的旧状态
+// 撤销：将备份区域整块写回 (超出网格的部分自动裁剪)
 void PlacePatternCommand::Undo(LifeGame &game) {
-    for (const auto &cell: m_affectedCells) {
-        game.SetCell(cell.x, cell.y, cell.oldState);
-    }
+    game.PasteRegion(m_x, m_y, m_backup);
 }
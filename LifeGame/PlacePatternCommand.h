@@ -1,17 +1,6 @@
 #pragma once
 #include "Command.h"
-#include <vector>
-
-/**
- * @brief 细胞状态结构体
- * 
- * 用于记录单个细胞在操作前的状态，以便撤销。
- */
-struct CellState {
-    int x; ///< X坐标
-    int y; ///< Y坐标
-    bool oldState; ///< 旧状态 (true=活, false=死)
-};
+#include "BitGrid.h"
 
 /**
  * @brief 放置图案命令 (Place Pattern Command)
@@ -41,7 +30,7 @@ public:
 
     /**
      * @brief 撤销命令
-     * 恢复所有受影响细胞的旧状态。
+     * 将备份的区域整块写回网格。
      */
     void Undo(LifeGame &game) override;
 
@@ -49,5 +38,5 @@ private:
     int m_x; ///< 放置位置 X
     int m_y; ///< 放置位置 Y
     int m_patternIndex; ///< 图案索引
-    std::vector<CellState> m_affectedCells; ///< 存储受影响细胞的旧状态
+    BitGrid m_backup; ///< 图案覆盖区域 (Bounding Box) 的旧状态快照
 };
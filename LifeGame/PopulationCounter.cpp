@@ -0,0 +1,105 @@
+#include "PopulationCounter.h"
+#include <algorithm>
+
+PopulationCounter::PopulationCounter() : m_population(0), m_births(0), m_deaths(0), m_valid(false) {
+}
+
+void PopulationCounter::Resize(int tileCount) {
+    m_tilePopulation.assign(tileCount, 0);
+    m_staged.assign(tileCount, CellCounts());
+    m_population = 0;
+    m_births = 0;
+    m_deaths = 0;
+    m_valid = false;
+}
+
+void PopulationCounter::Rebuild(ThreadPool &pool, const BitGrid &grid, const std::vector<Tile> &tiles) {
+    if (m_tilePopulation.size() != tiles.size()) Resize(static_cast<int>(tiles.size()));
+    pool.Run(static_cast<int>(tiles.size()), [&](int index) {
+        const Tile &tile = tiles[index];
+        long long count = 0;
+        for (int y = tile.firstRow; y < tile.lastRow; ++y) {
+            const uint64_t *row = grid.GetRow(y);
+            for (int w = tile.firstWord; w < tile.lastWord; ++w) {
+                count += PopCount64(row[w]);
+            }
+        }
+        m_tilePopulation[index] = count;
+    });
+    m_population = 0;
+    for (long long count: m_tilePopulation) {
+        m_population += count;
+    }
+    m_valid = true;
+}
+
+/**
+ * @brief 合并变化分块的计数
+ *
+ * 未变化的分块在前后缓冲中内容相同 (见 TileScheduler)，人口不变，出生/死亡为 0。
+ */
+void PopulationCounter::Commit(const TileScheduler &scheduler) {
+    const int tileCount = scheduler.GetTileCount();
+    m_births = 0;
+    m_deaths = 0;
+    for (int i = 0; i < tileCount; ++i) {
+        if (!scheduler.HasTileChanged(i)) continue;
+        const CellCounts &counts = m_staged[i];
+        m_population += counts.population - m_tilePopulation[i];
+        m_tilePopulation[i] = counts.population;
+        m_births += counts.births;
+        m_deaths += counts.deaths;
+    }
+}
+
+bool PopulationCounter::GetBoundingBox(const BitGrid &grid, const std::vector<Tile> &tiles, int &minX, int &minY,
+                                       int &maxX, int &maxY) const {
+    // 1. 非空分块的范围 (行 [top, bottom)，字 [left, right))
+    int top = grid.GetHeight();
+    int bottom = 0;
+    int left = grid.GetWordsPerRow();
+    int right = 0;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (m_tilePopulation[i] == 0) continue;
+        const Tile &tile = tiles[i];
+        top = std::min(top, tile.firstRow);
+        bottom = std::max(bottom, tile.lastRow);
+        left = std::min(left, tile.firstWord);
+        right = std::max(right, tile.lastWord);
+    }
+    if (top >= bottom) {
+        minX = minY = maxX = maxY = -1;
+        return false;
+    }
+
+    // 2. 从上下两端向内找第一行非空的行 (最外侧的分块行一定含有活细胞)
+    auto rowEmpty = [&](int y) {
+        const uint64_t *row = grid.GetRow(y);
+        for (int w = left; w < right; ++w) {
+            if (row[w] != 0) return false;
+        }
+        return true;
+    };
+    minY = top;
+    while (rowEmpty(minY)) minY++;
+    maxY = bottom - 1;
+    while (rowEmpty(maxY)) maxY--;
+
+    // 3. 从左右两端向内找第一个非空的字列，再由最低/最高置位得到列坐标
+    auto columnBits = [&](int w) {
+        uint64_t bits = 0;
+        for (int y = minY; y <= maxY; ++y) {
+            bits |= grid.GetRow(y)[w];
+        }
+        return bits;
+    };
+    int w = left;
+    uint64_t bits = columnBits(w);
+    while (bits == 0) bits = columnBits(++w);
+    minX = w * BitGrid::WORD_BITS + CountTrailingZeros64(bits);
+    w = right - 1;
+    bits = columnBits(w);
+    while (bits == 0) bits = columnBits(--w);
+    maxX = w * BitGrid::WORD_BITS + 63 - CountLeadingZeros64(bits);
+    return true;
+}
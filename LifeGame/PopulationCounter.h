@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include "BitGrid.h"
+#include "BitOps.h"
+#include "ThreadPool.h"
+#include "TileScheduler.h"
+
+/**
+ * @brief 增量人口计数
+ *
+ * 演化时各分块任务在比较前后两代的同一个循环里 popcount，得到分块下一代的人口与出生/死亡数 (StageTile)，
+ * 一代结束后只对本代变化的分块更新人口 (Commit)，未变化的分块人口不变、也没有出生与死亡。
+ * 因此获取人口是 O(1)，不再每帧扫描整个棋盘。
+ * 棋盘被直接编辑后调用 Invalidate，下次演化前整体重新计数一次。
+ */
+class PopulationCounter {
+public:
+    PopulationCounter();
+
+    /**
+     * @brief 按分块数重新分配 (计数随之失效)
+     */
+    void Resize(int tileCount);
+
+    /**
+     * @brief 标记计数失效 (棋盘被直接编辑、整体改写等)
+     */
+    void Invalidate() { m_valid = false; }
+
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * @brief 当前活细胞总数 (仅在 IsValid 时有意义)
+     */
+    long long GetPopulation() const { return m_population; }
+
+    /**
+     * @brief 最近一次 Commit 的那一代中出生的细胞数
+     */
+    long long GetBirths() const { return m_births; }
+
+    /**
+     * @brief 最近一次 Commit 的那一代中死亡的细胞数
+     */
+    long long GetDeaths() const { return m_deaths; }
+
+    /**
+     * @brief 求活细胞的外接矩形 (网格坐标，含两端)
+     *
+     * 先由各分块人口得到非空分块的范围，再只扫描边缘的行与字列细化到单个细胞，
+     * 代价约为 O(分块数 + 宽 + 高)，不扫描整个棋盘。计数必须有效 (IsValid)。
+     * @return bool 棋盘为空时返回 false，四个坐标均为 -1
+     */
+    bool GetBoundingBox(const BitGrid &grid, const std::vector<Tile> &tiles, int &minX, int &minY, int &maxX,
+                        int &maxY) const;
+
+    /**
+     * @brief 用线程池重新统计全部分块的人口
+     */
+    void Rebuild(ThreadPool &pool, const BitGrid &grid, const std::vector<Tile> &tiles);
+
+    /**
+     * @brief 分块任务写入计数的位置 (由各分块任务并行使用，互不干扰)
+     */
+    CellCounts *GetStage(const Tile &tile) { return &m_staged[tile.index]; }
+
+    /**
+     * @brief 把上一次 Run 中变化了的分块的计数并入总数
+     */
+    void Commit(const TileScheduler &scheduler);
+
+private:
+    std::vector<long long> m_tilePopulation; ///< 各分块当前的人口
+    std::vector<CellCounts> m_staged; ///< 本代各分块的计数 (只有变化的分块有效)
+    long long m_population; ///< 活细胞总数 (全部分块人口之和)
+    long long m_births; ///< 最近一代的出生数
+    long long m_deaths; ///< 最近一代的死亡数
+    bool m_valid; ///< 计数是否与棋盘一致
+};
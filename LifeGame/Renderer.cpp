@@ -16,7 +16,7 @@ Renderer::Renderer()
       m_viewOffsetX(0), m_viewOffsetY(0), m_hBackgroundBrush(nullptr),
       m_hAliveBrush(nullptr), m_hGlowBrush(nullptr), m_hDeadBrush(nullptr), m_hTipBrush(nullptr),
       m_hLeftPanelBrush(nullptr), m_hInputBgBrush(nullptr), m_hGridPen(nullptr), m_hBorderPen(nullptr),
-      m_hHUDPen(nullptr), m_hTitleFont(nullptr), m_hTipFont(nullptr), m_hBtnFont(nullptr),
+      m_hHUDPen(nullptr), m_hGraphRangePen(nullptr), m_hTitleFont(nullptr), m_hTipFont(nullptr), m_hBtnFont(nullptr),
       m_hControlFont(nullptr), m_hLeftKeyFont(nullptr),
       m_hLeftDescFont(nullptr), m_hBrandingFont(nullptr), m_hDataFont(nullptr), m_previewX(-1),
       m_previewY(-1), m_previewPatternIndex(-1),
@@ -57,6 +57,7 @@ bool Renderer::Initialize(HINSTANCE hInstance) {
     m_hBorderPen = CreatePen(PS_SOLID, 1, RGB(0, 100, 120)); // 边框
     m_hHUDPen = CreatePen(PS_SOLID, 2, RGB(0, 200, 220)); // HUD 装饰线
     m_hGraphPen = CreatePen(PS_SOLID, 1, RGB(0, 255, 100)); // 统计图表笔 (绿色)
+    m_hGraphRangePen = CreatePen(PS_SOLID, 1, RGB(0, 90, 40)); // 统计图表的最小-最大范围 (暗绿)
 
     // 2. 创建衰减画刷 (用于拖尾)
     // 从亮青色渐变到背景色
@@ -114,6 +115,7 @@ void Renderer::Cleanup() {
     if (m_hBorderPen) DeleteObject(m_hBorderPen);
     if (m_hHUDPen) DeleteObject(m_hHUDPen);
     if (m_hGraphPen) DeleteObject(m_hGraphPen);
+    if (m_hGraphRangePen) DeleteObject(m_hGraphRangePen);
     if (m_hEraserPen) DeleteObject(m_hEraserPen); // 新增
     if (m_hBackgroundBrush) DeleteObject(m_hBackgroundBrush);
     if (m_hAliveBrush) DeleteObject(m_hAliveBrush);
@@ -189,13 +191,13 @@ void Renderer::UpdateSettings() {
  * @brief 清除视觉残留
  */
 void Renderer::ClearVisuals() {
-    std::fill(m_visualGrid.begin(), m_visualGrid.end(), 0.0f);
+    std::fill(m_visualGrid.begin(), m_visualGrid.end(), static_cast<uint8_t>(0));
 }
 
 /**
  * @brief 更新视觉网格 (计算拖尾)
  *
- * 遍历所有细胞，如果细胞存活，亮度设为 1.0。
+ * 遍历所有细胞，如果细胞存活，亮度设为 255 (满亮度)。
  * 如果细胞死亡，亮度逐渐衰减，形成拖尾效果。
  */
 void Renderer::UpdateVisualGrid(const LifeGame &game) {
@@ -206,22 +208,45 @@ void Renderer::UpdateVisualGrid(const LifeGame &game) {
     if (w != m_visualW || h != m_visualH) {
         m_visualW = w;
         m_visualH = h;
-        m_visualGrid.assign(w * h, 0.0f);
+        m_visualGrid.assign(static_cast<size_t>(w) * h, 0);
     }
 
-    // 衰减系数
-    float decay = 0.15f;
+    // 衰减系数 (每帧减少约 15% 满亮度)
+    const int decay = 38;
+
+    // 直接按字读取位平面，避免逐细胞的边界检查
+    const BitGrid &grid = game.GetGrid();
+    if (game.IsGenerationsRule()) {
+        // Generations 规则：衰减中的细胞按剩余寿命显示亮度，复用死细胞拖尾的画刷
+        const StateGrid &states = game.GetStateGrid();
+        const int stateCount = game.GetStateCount();
+        for (int y = 0; y < h; ++y) {
+            const uint8_t *row = states.GetRow(y);
+            uint8_t *visual = &m_visualGrid[static_cast<size_t>(y) * w];
+            for (int x = 0; x < w; ++x) {
+                const int s = row[x];
+                uint8_t &v = visual[x];
+                if (s == 1) {
+                    v = 255;
+                } else if (s >= 2) {
+                    // 剩余寿命映射到 0 - 90% 亮度
+                    v = static_cast<uint8_t>(230 * (stateCount - s) / (stateCount - 2));
+                } else {
+                    v = static_cast<uint8_t>(v > decay ? v - decay : 0);
+                }
+            }
+        }
+        return;
+    }
 
     for (int y = 0; y < h; ++y) {
+        const uint64_t *row = grid.GetRow(y);
+        uint8_t *visual = &m_visualGrid[static_cast<size_t>(y) * w];
         for (int x = 0; x < w; ++x) {
-            int idx = y * w + x;
-            if (game.GetCell(x, y)) {
-                m_visualGrid[idx] = 1.0f; // 活细胞亮度拉满
-            } else {
-                if (m_visualGrid[idx] > 0.0f) {
-                    m_visualGrid[idx] -= decay; // 死细胞亮度衰减
-                    if (m_visualGrid[idx] < 0.0f) m_visualGrid[idx] = 0.0f;
-                }
+            if ((row[x >> 6] >> (x & 63)) & 1ULL) {
+                visual[x] = 255; // 活细胞亮度拉满
+            } else if (visual[x] > 0) {
+                visual[x] = static_cast<uint8_t>(visual[x] > decay ? visual[x] - decay : 0); // 死细胞亮度衰减
             }
         }
     }
@@ -504,13 +529,13 @@ void Renderer::DrawGrid(HDC hdc, const LifeGame &game, const RECT *pDirty,
     int h = game.GetHeight();
 
     // 确保 visualGrid 大小正确
-    if (m_visualGrid.size() != w * h) return;
+    if (m_visualGrid.size() != static_cast<size_t>(w) * h) return;
 
     for (int y = startRow; y < endRow; ++y) {
         for (int x = startCol; x < endCol; ++x) {
-            float brightness = m_visualGrid[y * w + x];
+            const int brightness = m_visualGrid[static_cast<size_t>(y) * w + x];
 
-            if (brightness > 0.01f) {
+            if (brightness > 2) {
                 int left = offX + x * cellSize;
                 int top = offY + y * cellSize;
                 // 简单的可见性检查 (其实上面循环已经保证了大部分)
@@ -519,7 +544,7 @@ void Renderer::DrawGrid(HDC hdc, const LifeGame &game, const RECT *pDirty,
 
                 RECT cell = {left, top, left + cellSize, top + cellSize};
 
-                if (brightness >= 0.99f) {
+                if (brightness == 255) {
                     if (cellSize > 4) {
                         RECT glow = cell;
                         InflateRect(&glow, 1, 1);
@@ -529,7 +554,7 @@ void Renderer::DrawGrid(HDC hdc, const LifeGame &game, const RECT *pDirty,
                     if (cellSize > 6) InflateRect(&core, -1, -1);
                     FillRect(hdc, &core, m_hAliveBrush);
                 } else {
-                    int level = static_cast<int>(brightness * FADE_LEVELS);
+                    int level = brightness * FADE_LEVELS / 256;
                     if (level < 0) level = 0;
                     if (level >= FADE_LEVELS) level = FADE_LEVELS - 1;
 
@@ -706,10 +731,10 @@ void Renderer::DrawStatusBar(HDC hdc, const LifeGame &game, int clientWidth, int
              DT_LEFT | DT_VCENTER | DT_SINGLELINE);
 
     // 2. 种群数量能量条
-    int pop = game.GetPopulation();
-    int maxPop = game.GetWidth() * game.GetHeight() / 2; // 估算最大值
+    const long long pop = game.GetPopulation();
+    long long maxPop = static_cast<long long>(game.GetWidth()) * game.GetHeight() / 2; // 估算最大值
     if (maxPop < 1) maxPop = 1;
-    float ratio = static_cast<float>(pop) / maxPop;
+    float ratio = static_cast<float>(static_cast<double>(pop) / maxPop);
     if (ratio > 1.0f) ratio = 1.0f;
 
     int barW = 200;
@@ -732,17 +757,25 @@ void Renderer::DrawStatusBar(HDC hdc, const LifeGame &game, int clientWidth, int
 
     // 绘制文字
     TCHAR popText[64];
-    _stprintf_s(popText, TEXT("POPULATION: %d"), pop);
+    _stprintf_s(popText, TEXT("POPULATION: %lld"), pop);
     // 增加文本区域宽度，防止数字被截断
     RECT popTextRect = {barX + barW + 10, clientHeight - STATUS_BAR_HEIGHT, barX + barW + 250, clientHeight};
     SetTextColor(hdc, m_colHighlight);
     DrawText(hdc, popText, -1, &popTextRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE);
 
-    // 3. 右侧信息
-    TCHAR rightStatus[128];
-    _stprintf_s(rightStatus, TEXT("GRID: %dx%d | SPEED: %dms"),
-                game.GetWidth(), game.GetHeight(), game.GetSpeed());
-    RECT rightRect = {clientWidth - 250, clientHeight - STATUS_BAR_HEIGHT, clientWidth - 16, clientHeight};
+    // 3. 右侧信息 (进入周期后显示周期与起始代数)
+    TCHAR rightStatus[192];
+    TCHAR cycleText[64] = TEXT("");
+    const Statistics &stats = game.GetStatistics();
+    const CycleInfo &cycle = stats.GetCycleInfo();
+    if (cycle.detected) {
+        _stprintf_s(cycleText, TEXT(" | CYCLE: P%lld @%s%lld"), cycle.period, cycle.startExact ? TEXT("") : TEXT("<="),
+                    cycle.startGeneration);
+    }
+    _stprintf_s(rightStatus, TEXT("GEN: %lld%s | TILES: %d/%d | GRID: %dx%d | SPEED: %dms x%d"),
+                game.GetGeneration(), cycleText, stats.GetActiveTileCount(), stats.GetTileCount(),
+                game.GetWidth(), game.GetHeight(), game.GetSpeed(), game.GetGenerationsPerTick());
+    RECT rightRect = {clientWidth - 560, clientHeight - STATUS_BAR_HEIGHT, clientWidth - 16, clientHeight};
     SetTextColor(hdc, m_colTextDim);
     DrawText(hdc, rightStatus, -1, &rightRect, DT_RIGHT | DT_VCENTER | DT_SINGLELINE);
 }
@@ -775,32 +808,42 @@ void Renderer::DrawStatistics(HDC hdc, const LifeGame &game, int x, int y, int w
     SelectObject(hdc, hOldPen);
     DeleteObject(hBorder);
 
-    // 获取数据
-    const auto &history = game.GetStatistics().GetPopulationHistory();
-    if (history.size() < 2) return;
+    // 获取数据：从金字塔中取出整个运行过程，按图表宽度汇总 (每像素一列，代价与运行的代数无关)
+    const HistoryPyramid &pyramid = game.GetStatistics().GetPopulationPyramid();
+    pyramid.Query(0, pyramid.GetCount(), w, m_chartBuckets);
+    const int count = static_cast<int>(m_chartBuckets.size());
+    if (count < 2) return;
 
-    int maxPop = game.GetStatistics().GetMaxPopulation();
+    long long maxPop = 0;
+    for (const HistoryBucket &bucket: m_chartBuckets) {
+        if (bucket.max > maxPop) maxPop = bucket.max;
+    }
     if (maxPop == 0) maxPop = 100; // 避免除零
 
-    // 绘制曲线
-    SelectObject(hdc, m_hGraphPen);
-
-    int count = static_cast<int>(history.size());
     float stepX = static_cast<float>(w) / (count - 1);
-
-    auto getPt = [&](int i) -> POINT {
-        int val = history[i];
-        int px = x + static_cast<int>(i * stepX);
-        int py = (y + h) - static_cast<int>(static_cast<float>(val) / maxPop * (h - 10)) - 5; // 留出边距
-        return {px, py};
+    auto getX = [&](int i) { return x + static_cast<int>(i * stepX); };
+    auto getY = [&](double val) {
+        return (y + h) - static_cast<int>(val / maxPop * (h - 10)) - 5; // 留出边距
     };
 
-    POINT pt = getPt(0);
-    MoveToEx(hdc, pt.x, pt.y, nullptr);
+    // 每列的最小-最大范围 (一列汇总了多代时显示其中的波动)
+    SelectObject(hdc, m_hGraphRangePen);
+    for (int i = 0; i < count; ++i) {
+        const HistoryBucket &bucket = m_chartBuckets[i];
+        if (bucket.min == bucket.max) continue;
+        MoveToEx(hdc, getX(i), getY(static_cast<double>(bucket.max)), nullptr);
+        LineTo(hdc, getX(i), getY(static_cast<double>(bucket.min)) + 1);
+    }
 
+    // 平均值曲线
+    SelectObject(hdc, m_hGraphPen);
+    auto getMean = [&](int i) {
+        const HistoryBucket &bucket = m_chartBuckets[i];
+        return static_cast<double>(bucket.sum) / bucket.count;
+    };
+    MoveToEx(hdc, getX(0), getY(getMean(0)), nullptr);
     for (int i = 1; i < count; ++i) {
-        pt = getPt(i);
-        LineTo(hdc, pt.x, pt.y);
+        LineTo(hdc, getX(i), getY(getMean(i)));
     }
 }
 
@@ -127,9 +127,10 @@ private:
 	void DrawStatistics(HDC hdc, const LifeGame& game, int x, int y, int w, int h);
 
 	// 视觉增强数据 (Visual Enhancement)
-	std::vector<float> m_visualGrid; ///< 存储每个细胞的亮度值 (0.0 - 1.0)，用于实现拖尾
+	std::vector<uint8_t> m_visualGrid; ///< 存储每个细胞的亮度值 (0 - 255)，用于实现拖尾 (每细胞 1 字节，见 LifeGame::VIEW_BYTES_PER_CELL)
 	int m_visualW, m_visualH;
 	void UpdateVisualGrid(const LifeGame& game); ///< 更新亮度网格，计算衰减
+	std::vector<HistoryBucket> m_chartBuckets; ///< 统计图表每列的汇总 (复用容量，避免每次绘制分配)
 
 	// 视图状态 (View State)
 	float m_scale; ///< 当前缩放比例
@@ -153,6 +154,7 @@ private:
 	HPEN m_hBorderPen;
 	HPEN m_hHUDPen; // HUD 装饰线笔
 	HPEN m_hGraphPen; // 统计图表笔
+	HPEN m_hGraphRangePen; // 统计图表的最小-最大范围笔
 
 	// 字体资源
 	HFONT m_hTitleFont;
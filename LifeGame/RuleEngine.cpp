@@ -1,6 +1,87 @@
 #include "RuleEngine.h"
 #include <sstream>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+/**
+ * @brief Hensel 记法的字母
+ *
+ * 邻居数为 n 时可用的字母，按记法的标准顺序排列；邻居数 5-8 与 8-n 使用相同的字母。
+ */
+static const char *const HENSEL_LETTERS[5] = {"", "ce", "ceaikn", "ceaiknjqry", "ceaiknjqrtwyz"};
+
+/**
+ * @brief 每个字母的代表构型 (3x3 邻域下标，中心位为 0)
+ *
+ * 同一字母的其余构型由 8 种旋转/翻转生成。邻居数 5-8 的构型是 8-n 同一字母构型的补集。
+ */
+static const int HENSEL_PATTERNS[5][13] = {
+    {0},
+    {1, 2},
+    {5, 10, 3, 40, 33, 68},
+    {69, 42, 11, 7, 98, 13, 14, 70, 41, 97},
+    {325, 170, 15, 45, 99, 71, 106, 102, 43, 105, 78, 101, 108}
+};
+
+/**
+ * @brief 把 3x3 邻域下标做一次对称变换 (旋转 rotation 个 90 度，mirror 时先左右翻转)
+ */
+static unsigned TransformNeighborhood(unsigned index, int rotation, bool mirror) {
+    unsigned result = 0;
+    for (int bit = 0; bit < 9; ++bit) {
+        if (!((index >> bit) & 1u)) continue;
+        int x = bit % 3 - 1;
+        int y = bit / 3 - 1;
+        if (mirror) x = -x;
+        for (int r = 0; r < rotation; ++r) {
+            const int t = x;
+            x = -y;
+            y = t;
+        }
+        result |= 1u << ((y + 1) * 3 + (x + 1));
+    }
+    return result;
+}
+
+/**
+ * @brief 每个 3x3 邻域 (忽略中心) 在 Hensel 记法中的字母序号
+ */
+struct HenselLetterTable {
+    uint8_t letters[512];
+
+    /**
+     * @brief 由代表构型生成整张表
+     *
+     * 邻居数 1-3 的构型顺带写入补集 (邻居数 5-7，同一字母)。
+     * 邻居数 4 的补集仍是 4 个邻居，但多数属于另一个字母 (c/e、i/t、n/r、j/y、q/w 互为补集)，
+     * 由它们自己的代表构型生成，不能按补集写入。
+     */
+    HenselLetterTable() : letters() {
+        for (int n = 1; n <= 4; ++n) {
+            const int count = static_cast<int>(strlen(HENSEL_LETTERS[n]));
+            for (int k = 0; k < count; ++k) {
+                for (int t = 0; t < 8; ++t) {
+                    const unsigned index = TransformNeighborhood(HENSEL_PATTERNS[n][k], t & 3, t >= 4);
+                    letters[index] = letters[index | CompiledRule::CENTER_BIT] = static_cast<uint8_t>(k);
+                    if (n == 4) continue;
+                    const unsigned complement = index ^ 0x1EFu; // 8 个邻居取反，中心位不变
+                    letters[complement] = letters[complement | CompiledRule::CENTER_BIT] = static_cast<uint8_t>(k);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief 获取 Hensel 字母表 (首次调用时生成，局部静态变量的初始化是线程安全的)
+ */
+static const uint8_t *GetHenselLetters() {
+    static const HenselLetterTable table;
+    return table.letters;
+}
 
 /**
  * @brief 构造函数
@@ -44,12 +125,43 @@ const RuleData *RuleEngine::GetRule(int index) const {
  * @return true 成功
  */
 bool RuleEngine::ParseRule(const std::string &ruleStr, std::set<int> &outBirth, std::set<int> &outSurvival) {
+    int states = 2;
+    return ParseRule(ruleStr, outBirth, outSurvival, states);
+}
+
+/**
+ * @brief 解析规则字符串 (含状态数)
+ *
+ * 先取出状态数部分 ("/C4" 或 Golly 记法的第三段)，剩余部分按 B/S 记法解析。
+ */
+bool RuleEngine::ParseRule(const std::string &ruleStr, std::set<int> &outBirth, std::set<int> &outSurvival,
+                           int &outStates) {
     outBirth.clear();
     outSurvival.clear();
+    outStates = 2;
 
     std::string upperStr = ruleStr;
     std::transform(upperStr.begin(), upperStr.end(), upperStr.begin(), toupper);
 
+    size_t statesPos = upperStr.find('C');
+    if (statesPos != std::string::npos) {
+        // "B2/S345/C4"：C 之后是状态数
+        outStates = atoi(upperStr.c_str() + statesPos + 1);
+        if (statesPos > 0 && upperStr[statesPos - 1] == '/') statesPos--;
+        upperStr.erase(statesPos);
+    } else if (std::count(upperStr.begin(), upperStr.end(), '/') == 2 &&
+               upperStr.find_first_of("BS") == std::string::npos) {
+        // Golly 记法 "345/2/4"：存活/出生/状态数
+        const size_t first = upperStr.find('/');
+        const size_t second = upperStr.find('/', first + 1);
+        outStates = atoi(upperStr.c_str() + second + 1);
+        upperStr = "S" + upperStr.substr(0, first) + "/B" + upperStr.substr(first + 1, second - first - 1);
+    }
+    if (outStates < 2 || outStates > 255) {
+        outStates = 2;
+        return false;
+    }
+
     bool parsingBirth = false;
     bool parsingSurvival = false;
 
@@ -108,19 +220,388 @@ bool RuleEngine::ParseRule(const std::string &ruleStr, std::set<int> &outBirth,
     return true;
 }
 
+/**
+ * @brief 解析 Hensel 记法
+ *
+ * 按 "/" 分段，每段以 B、S 或 C 开头。B/S 段中数字开始一组，之后的字母 (可带前导 "-") 限定构型。
+ */
+bool RuleEngine::ParseIsotropicRule(const std::string &ruleStr, uint16_t outBirth[9], uint16_t outSurvival[9],
+                                    int &outStates) {
+    memset(outBirth, 0, sizeof(uint16_t) * 9);
+    memset(outSurvival, 0, sizeof(uint16_t) * 9);
+    outStates = 2;
+
+    auto letterCount = [](int n) { return n == 0 || n == 8 ? 1 : static_cast<int>(strlen(HENSEL_LETTERS[n <= 4 ? n : 8 - n])); };
+
+    std::stringstream ss(ruleStr);
+    std::string part;
+    while (std::getline(ss, part, '/')) {
+        if (part.empty()) continue;
+        const char kind = static_cast<char>(toupper(static_cast<unsigned char>(part[0])));
+        if (kind == 'C') {
+            outStates = atoi(part.c_str() + 1);
+            if (outStates < 2 || outStates > 255) return false;
+            continue;
+        }
+        if (kind != 'B' && kind != 'S') return false;
+        uint16_t *masks = kind == 'B' ? outBirth : outSurvival;
+
+        int n = -1; // 当前组的邻居数
+        bool exclude = false;
+        uint16_t letters = 0;
+        auto flush = [&]() {
+            if (n < 0) return;
+            const uint16_t all = static_cast<uint16_t>((1u << letterCount(n)) - 1);
+            masks[n] |= letters == 0 ? all : (exclude ? static_cast<uint16_t>(all & ~letters) : letters);
+        };
+        for (size_t i = 1; i < part.size(); ++i) {
+            const char c = part[i];
+            if (isdigit(static_cast<unsigned char>(c))) {
+                flush();
+                n = c - '0';
+                if (n > 8) return false;
+                exclude = false;
+                letters = 0;
+            } else if (c == '-' && n >= 0 && letters == 0 && !exclude) {
+                exclude = true;
+            } else {
+                if (n <= 0 || n >= 8) return false;
+                const char *table = HENSEL_LETTERS[n <= 4 ? n : 8 - n];
+                const char *found = strchr(table, tolower(static_cast<unsigned char>(c)));
+                if (!found) return false;
+                letters |= static_cast<uint16_t>(1u << (found - table));
+            }
+        }
+        if (exclude && letters == 0) return false;
+        flush();
+    }
+    return true;
+}
+
+/**
+ * @brief 按给定的变量顺序展开邻域表，生成化简的决策图
+ *
+ * order[d] 为第 d 层展开的变量。每层记录已生成的子函数 (按剩余变量的真值表)，
+ * 相同的子函数只生成一次；两个分支相同的节点直接省去。
+ */
+struct NeighborhoodNetworkBuilder {
+    const uint64_t *table; ///< 512 位邻域表
+    const int *order; ///< 展开顺序
+    NeighborhoodNetwork network; ///< 输出
+    std::map<std::vector<uint8_t>, uint8_t> subfunctions[9]; ///< 各层已生成的子函数 -> 求值下标
+    bool overflow; ///< 节点数超过上限
+
+    NeighborhoodNetworkBuilder(const uint64_t *neighborhood, const int *variableOrder)
+        : table(neighborhood), order(variableOrder), network(), overflow(false) {
+    }
+
+    /**
+     * @param depth 已展开的层数
+     * @param fixed 已展开变量的取值 (邻域下标中对应的位)
+     * @return uint8_t 子函数在求值数组中的下标
+     */
+    uint8_t Build(int depth, unsigned fixed) {
+        const int rest = 9 - depth;
+        std::vector<uint8_t> truth(size_t(1) << rest);
+        bool any = false;
+        bool all = true;
+        for (unsigned a = 0; a < truth.size(); ++a) {
+            unsigned index = fixed;
+            for (int j = 0; j < rest; ++j) {
+                if ((a >> j) & 1u) index |= 1u << order[depth + j];
+            }
+            truth[a] = static_cast<uint8_t>((table[index >> 6] >> (index & 63)) & 1ULL);
+            any = any || truth[a];
+            all = all && truth[a];
+        }
+        if (!any) return 0;
+        if (all) return 1;
+
+        const auto found = subfunctions[depth].find(truth);
+        if (found != subfunctions[depth].end()) return found->second;
+
+        const uint8_t low = Build(depth + 1, fixed);
+        const uint8_t high = Build(depth + 1, fixed | (1u << order[depth]));
+        uint8_t result = low;
+        if (low != high) {
+            if (network.nodeCount >= NeighborhoodNetwork::MAX_NODES) {
+                overflow = true;
+                return 0;
+            }
+            NeighborhoodNode &node = network.nodes[network.nodeCount];
+            node.var = static_cast<uint8_t>(order[depth]);
+            node.low = low;
+            node.high = high;
+            result = static_cast<uint8_t>(2 + network.nodeCount++);
+        }
+        subfunctions[depth][truth] = result;
+        return result;
+    }
+};
+
+/**
+ * @brief 为邻域表生成布尔网络
+ *
+ * 网络大小取决于展开顺序，这里试几种常见顺序 (中心最后、先角后边等)，保留节点最少的一个。
+ */
+static void BuildNeighborhoodNetwork(CompiledRule &rule) {
+    static const int ORDERS[][9] = {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8},
+        {0, 1, 2, 3, 5, 6, 7, 8, 4},
+        {0, 2, 6, 8, 1, 3, 5, 7, 4},
+        {1, 3, 5, 7, 0, 2, 6, 8, 4},
+    };
+    rule.network = NeighborhoodNetwork();
+    for (const int *order: ORDERS) {
+        NeighborhoodNetworkBuilder builder(rule.neighborhood, order);
+        builder.network.output = builder.Build(0, 0);
+        if (builder.overflow) continue;
+        if (!rule.network.built || builder.network.nodeCount < rule.network.nodeCount) {
+            rule.network = builder.network;
+            rule.network.built = true;
+        }
+    }
+}
+
+/**
+ * @brief 编译非全和规则
+ *
+ * 按 512 个邻域逐一查字母表求值，同时判断是否退化为全和规则；仍为非全和规则时再生成邻域网络。
+ */
+CompiledRule RuleEngine::CompileIsotropicRule(const uint16_t birth[9], const uint16_t survival[9], int states) {
+    const uint8_t *letters = GetHenselLetters();
+    CompiledRule rule = {};
+    rule.states = static_cast<uint8_t>(states);
+    for (int n = 0; n <= 8; ++n) {
+        const int count = n == 0 || n == 8 ? 1 : static_cast<int>(strlen(HENSEL_LETTERS[n <= 4 ? n : 8 - n]));
+        const uint16_t all = static_cast<uint16_t>((1u << count) - 1);
+        if (birth[n] == all) rule.transitions |= 1u << n;
+        if (survival[n] == all) rule.transitions |= 1u << (n + CompiledRule::SURVIVAL_SHIFT);
+        if ((birth[n] != 0 && birth[n] != all) || (survival[n] != 0 && survival[n] != all)) {
+            rule.nonTotalistic = true;
+        }
+    }
+
+    for (unsigned index = 0; index < 512; ++index) {
+        const bool alive = (index & CompiledRule::CENTER_BIT) != 0;
+        int neighbors = 0;
+        for (unsigned bits = index & ~CompiledRule::CENTER_BIT; bits; bits &= bits - 1) {
+            neighbors++;
+        }
+        const uint16_t mask = alive ? survival[neighbors] : birth[neighbors];
+        if ((mask >> letters[index]) & 1u) {
+            rule.neighborhood[index >> 6] |= 1ULL << (index & 63);
+        }
+    }
+    if (rule.nonTotalistic) BuildNeighborhoodNetwork(rule);
+    return rule;
+}
+
+/**
+ * @brief 解析 Larger than Life 规则字符串
+ *
+ * 必须以 "R" 加数字开头，以免与 B/S 记法混淆。
+ */
+bool RuleEngine::ParseLtlRule(const std::string &ruleStr, LtlRule &outRule, int &outStates) {
+    outRule = LtlRule();
+    outStates = 2;
+
+    std::string upperStr = ruleStr;
+    std::transform(upperStr.begin(), upperStr.end(), upperStr.begin(), toupper);
+    if (upperStr.size() < 2 || upperStr[0] != 'R' || !isdigit(static_cast<unsigned char>(upperStr[1]))) {
+        return false;
+    }
+
+    int radius = 0;
+    int states = 0;
+    bool hasBirth = false;
+    bool hasSurvival = false;
+    std::stringstream ss(upperStr);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        if (field.empty()) continue;
+        const char key = field[0];
+        const char *value = field.c_str() + 1;
+        if (key == 'R') {
+            radius = atoi(value);
+        } else if (key == 'C') {
+            states = atoi(value);
+        } else if (key == 'M') {
+            outRule.countCenter = atoi(value) != 0;
+        } else if (key == 'N') {
+            if (field == "NN") outRule.vonNeumann = true;
+            else if (field != "NM") return false;
+        } else if (key == 'B' || key == 'S') {
+            // "a..b"；只有一个数时表示单点区间
+            const size_t dots = field.find("..");
+            const int lo = atoi(value);
+            const int hi = dots != std::string::npos ? atoi(field.c_str() + dots + 2) : lo;
+            if (lo < 0 || hi < lo || hi > 65535) return false;
+            if (key == 'B') {
+                outRule.birthMin = static_cast<uint16_t>(lo);
+                outRule.birthMax = static_cast<uint16_t>(hi);
+                hasBirth = true;
+            } else {
+                outRule.survivalMin = static_cast<uint16_t>(lo);
+                outRule.survivalMax = static_cast<uint16_t>(hi);
+                hasSurvival = true;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    if (radius < 1 || radius > LtlRule::MAX_RADIUS || states < 0 || states > 255 || states == 1) return false;
+    if (!hasBirth || !hasSurvival) return false;
+    outRule.radius = static_cast<uint8_t>(radius);
+    outStates = states < 2 ? 2 : states;
+    return true;
+}
+
+/**
+ * @brief 编译 LtL 规则
+ *
+ * 半径 1 的 Moore 邻域就是普通的 3x3 邻域：把区间展开为集合后复用 CompileRule，
+ * M1 时存活计数包含中心自身，折算为邻居数时要减 1。
+ */
+CompiledRule RuleEngine::CompileLtlRule(const LtlRule &ltl, int states) {
+    if (ltl.radius == 1 && !ltl.vonNeumann) {
+        std::set<int> birth, survival;
+        for (int n = ltl.birthMin; n <= ltl.birthMax && n <= 8; ++n) birth.insert(n);
+        const int shift = ltl.countCenter ? 1 : 0;
+        for (int n = ltl.survivalMin; n <= ltl.survivalMax && n - shift <= 8; ++n) {
+            if (n - shift >= 0) survival.insert(n - shift);
+        }
+        return CompileRule(birth, survival, states);
+    }
+
+    CompiledRule rule = {};
+    rule.states = static_cast<uint8_t>(states);
+    rule.ltl = ltl;
+    return rule;
+}
+
+/**
+ * @brief 编译规则
+ *
+ * 先把集合压缩成 18 位掩码，再枚举全部 512 种 3x3 邻域：
+ * 中心位决定查出生还是存活，其余 8 位的 popcount 即邻居数。
+ */
+CompiledRule RuleEngine::CompileRule(const std::set<int> &birth, const std::set<int> &survival, int states) {
+    CompiledRule rule = {};
+    rule.states = static_cast<uint8_t>(states);
+    for (int n: birth) {
+        if (n >= 0 && n <= 8) rule.transitions |= 1u << n;
+    }
+    for (int n: survival) {
+        if (n >= 0 && n <= 8) rule.transitions |= 1u << (n + CompiledRule::SURVIVAL_SHIFT);
+    }
+
+    for (unsigned index = 0; index < 512; ++index) {
+        const bool alive = (index & CompiledRule::CENTER_BIT) != 0;
+        int neighbors = 0;
+        for (unsigned bits = index & ~CompiledRule::CENTER_BIT; bits; bits &= bits - 1) {
+            neighbors++;
+        }
+        if (rule.NextState(alive, neighbors)) {
+            rule.neighborhood[index >> 6] |= 1ULL << (index & 63);
+        }
+    }
+    return rule;
+}
+
+/**
+ * @brief 获取预编译规则
+ */
+const CompiledRule *RuleEngine::GetCompiledRule(int index) const {
+    const RuleData *rule = GetRule(index);
+    return rule ? &rule->compiled : nullptr;
+}
+
+/**
+ * @brief 添加自定义规则
+ */
+int RuleEngine::AddCustomRule(const std::wstring &name, const std::string &ruleStr) {
+    RuleData d;
+    d.name = name;
+    d.description = L"自定义规则 (" + std::wstring(ruleStr.begin(), ruleStr.end()) + L")。";
+    d.ruleString = ruleStr;
+    if (!BuildRule(ruleStr, d)) return -1;
+    m_rules.push_back(d);
+    return static_cast<int>(m_rules.size()) - 1;
+}
+
+/**
+ * @brief 按规则字符串查找规则
+ *
+ * 半径 1 的 Moore LtL 规则与等价的 B/S 规则视为同一条规则。
+ */
+int RuleEngine::FindRule(const std::string &ruleStr) {
+    RuleData d;
+    if (!BuildRule(ruleStr, d)) return -1;
+    const LtlRule &ltl = d.compiled.ltl;
+    for (size_t i = 0; i < m_rules.size(); ++i) {
+        const RuleData &r = m_rules[i];
+        const LtlRule &other = r.compiled.ltl;
+        if (r.birth == d.birth && r.survival == d.survival && r.states == d.states &&
+            other.radius == ltl.radius && other.vonNeumann == ltl.vonNeumann &&
+            memcmp(r.compiled.neighborhood, d.compiled.neighborhood, sizeof(d.compiled.neighborhood)) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 解析并编译规则
+ *
+ * LtL 规则的集合记录区间内的全部取值，存活集合按 M 折算为不含中心的邻居数，
+ * 因此 M0/M1 两种写法的同一条规则比较时相等。
+ */
+bool RuleEngine::BuildRule(const std::string &ruleStr, RuleData &out) {
+    LtlRule ltl;
+    if (ParseLtlRule(ruleStr, ltl, out.states)) {
+        out.birth.clear();
+        out.survival.clear();
+        for (int n = ltl.birthMin; n <= ltl.birthMax; ++n) out.birth.insert(n);
+        const int shift = ltl.countCenter ? 1 : 0;
+        for (int n = ltl.survivalMin; n <= ltl.survivalMax; ++n) {
+            if (n - shift >= 0) out.survival.insert(n - shift);
+        }
+        out.compiled = CompileLtlRule(ltl, out.states);
+        return true;
+    }
+
+    // 含构型字母的 Hensel 记法；纯数字的规则仍交给下面的 B/S 解析 (兼容无前缀等写法)
+    uint16_t birthMasks[9], survivalMasks[9];
+    if (ParseIsotropicRule(ruleStr, birthMasks, survivalMasks, out.states)) {
+        const CompiledRule compiled = CompileIsotropicRule(birthMasks, survivalMasks, out.states);
+        if (compiled.IsNonTotalistic()) {
+            // 集合记录至少有一种构型出生/存活的邻居数
+            out.birth.clear();
+            out.survival.clear();
+            for (int n = 0; n <= 8; ++n) {
+                if (birthMasks[n]) out.birth.insert(n);
+                if (survivalMasks[n]) out.survival.insert(n);
+            }
+            out.compiled = compiled;
+            return true;
+        }
+    }
+    if (!ParseRule(ruleStr, out.birth, out.survival, out.states)) return false;
+    out.compiled = CompileRule(out.birth, out.survival, out.states);
+    return true;
+}
+
 /**
  * @brief 计算下一代状态
  */
 bool RuleEngine::CalculateNextState(bool currentState, int neighbors, int ruleIndex) const {
-    const RuleData *rule = GetRule(ruleIndex);
-    if (!rule) return currentState; // 默认保持不变
+    const CompiledRule *rule = GetCompiledRule(ruleIndex);
+    if (!rule || neighbors < 0 || neighbors > 8) return currentState; // 默认保持不变
 
-    if (currentState) {
-        // 存活检查
-        return rule->survival.count(neighbors) > 0;
-    }
-    // 出生检查
-    return rule->birth.count(neighbors) > 0;
+    // 出生/存活判定都只是一次移位与按位与
+    return rule->NextState(currentState, neighbors);
 }
 
 /**
@@ -135,7 +616,7 @@ void RuleEngine::InitBuiltinRules() {
         d.name = name;
         d.description = desc;
         d.ruleString = rule;
-        ParseRule(rule, d.birth, d.survival);
+        BuildRule(rule, d);
         m_rules.push_back(d);
     };
 
@@ -198,4 +679,37 @@ void RuleEngine::InitBuiltinRules() {
 
     // 20. Walled Cities
     add(L"Walled Cities", L"形成围墙城市 (B45678/S2345)。", "B45678/S2345");
+
+    // 以下为 Generations 规则：活细胞死亡前会经过若干衰减态
+
+    // 21. Brian's Brain
+    add(L"Brian's Brain", L"三态规则，活细胞下一代必然进入衰减态，产生大量飞船 (B2/S/C3)。", "B2/S/C3");
+
+    // 22. Star Wars
+    add(L"Star Wars (星球大战)", L"四态规则，衰减尾迹形成类似光剑的结构 (B2/S345/C4)。", "B2/S345/C4");
+
+    // 23. Swirl
+    add(L"Swirl (漩涡)", L"八态规则，形成旋转的螺旋波 (B34/S23/C8)。", "B34/S23/C8");
+
+    // 以下为各向同性非全和规则 (Hensel 记法)：同样的邻居数，按邻居的排列方式决定出生/存活
+
+    // 24. tlife
+    add(L"tlife", L"与经典规则相近，但有大量新的振荡器与飞船 (B3/S2-i34q)。", "B3/S2-i34q");
+
+    // 25. Just Friends
+    add(L"Just Friends", L"两个不相邻的邻居才能出生，活细胞只在 1 或 2 个邻居时存活 (B2-a/S12)。", "B2-a/S12");
+
+    // 以下为 Larger than Life 规则：半径 R 的大邻域，按活细胞数所在区间决定出生/存活
+
+    // 26. Bosco's Rule
+    add(L"Bosco (LtL)", L"半径 5 的正方形邻域，存在大型滑翔机 \"Bosco\" (R5,C0,M1,S34..58,B34..45,NM)。",
+        "R5,C0,M1,S34..58,B34..45,NM");
+
+    // 27. Majority
+    add(L"Majority (LtL)", L"半径 4 的多数表决规则，随机初态迅速凝结成平滑的色块 (R4,C0,M1,S41..81,B41..81,NM)。",
+        "R4,C0,M1,S41..81,B41..81,NM");
+
+    // 28. Bugsmovie
+    add(L"Bugsmovie (LtL)", L"半径 10 的正方形邻域，演化出会移动的 \"虫子\" (R10,C0,M1,S123..212,B123..170,NM)。",
+        "R10,C0,M1,S123..212,B123..170,NM");
 }
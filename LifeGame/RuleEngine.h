@@ -2,26 +2,31 @@
 #include <string>
 #include <vector>
 #include <set>
+#include "CompiledRule.h"
 
 /**
  * @brief 规则定义结构
  * 
  * 存储一个具体的细胞自动机规则。
- * 包括规则名称、描述以及出生/存活条件。
+ * 包括规则名称、描述、出生/存活条件，以及预编译后的转移表。
  */
 struct RuleData {
     std::wstring name; ///< 规则名称
     std::wstring description; ///< 规则描述
     std::string ruleString; ///< 规则字符串 (例如 "B3/S23")
-    std::set<int> birth; ///< 出生所需的邻居数量集合
-    std::set<int> survival; ///< 存活所需的邻居数量集合
+    std::set<int> birth; ///< 出生所需的邻居数量集合 (LtL 规则为区间内的全部取值)
+    std::set<int> survival; ///< 存活所需的邻居数量集合 (LtL 规则为区间内的全部取值，已按 M 折算为不含中心)
+    int states; ///< 状态数 (2 为普通 B/S 规则，大于 2 为 Generations 规则)
+    CompiledRule compiled; ///< 由 birth/survival/states (及 LtL 参数) 编译得到的转移表 (演化内核使用)
 };
 
 /**
  * @brief 规则引擎类
  * 
  * 负责解析规则字符串，管理预设规则，并执行状态转换逻辑。
- * 支持标准的 B/S 记法。
+ * 支持标准的 B/S 记法，带状态数的 Generations 记法 (例如 "B2/S345/C4")，
+ * Hensel 的各向同性非全和记法 (例如 "B2-a3/S23")，
+ * 以及 Larger than Life 记法 (例如 "R5,C0,M1,S34..58,B34..45,NM")。
  */
 class RuleEngine {
 public:
@@ -62,10 +67,103 @@ public:
      */
     bool ParseRule(const std::string &ruleStr, std::set<int> &outBirth, std::set<int> &outSurvival);
 
+    /**
+     * @brief 解析规则字符串 (含状态数)
+     *
+     * 在 B/S 记法之外，还接受 Generations 记法 "B2/S345/C4" 以及 Golly 的 "345/2/4" (S/B/C)。
+     * 不含状态数时 outStates 为 2。
+     *
+     * @param outStates 输出的状态数
+     * @return false 状态数不在 2 - 255 范围内
+     */
+    bool ParseRule(const std::string &ruleStr, std::set<int> &outBirth, std::set<int> &outSurvival, int &outStates);
+
+    /**
+     * @brief 解析各向同性非全和规则字符串 (Hensel 记法)
+     *
+     * 每个邻居数之后可以跟字母，限定只有这些构型 (在旋转/翻转下等价的一类 3x3 邻域) 出生/存活；
+     * 字母前加 "-" 表示排除这些构型。例如 "B2-a3/S23" 表示 2 个邻居且不相邻时出生。
+     * 可选的 "/Cn" 给出 Generations 状态数。B、S 前缀必须写出。
+     *
+     * @param outBirth 输出的出生构型，第 n 项的第 k 位表示邻居数 n 的第 k 个字母 (按 "ceaiknjqrtwyz" 顺序)
+     * @param outSurvival 输出的存活构型，格式同上
+     * @param outStates 输出的状态数
+     * @return false 语法错误或字母不适用于该邻居数
+     */
+    bool ParseIsotropicRule(const std::string &ruleStr, uint16_t outBirth[9], uint16_t outSurvival[9],
+                            int &outStates);
+
+    /**
+     * @brief 把非全和构型编译为 512 位邻域表
+     *
+     * 每个邻居数的构型都全选或全不选时，结果与 CompileRule 相同且 nonTotalistic 为 false；
+     * 否则同时生成邻域表的布尔网络 (CompiledRule::network)，供行内核按位并行求值。
+     */
+    static CompiledRule CompileIsotropicRule(const uint16_t birth[9], const uint16_t survival[9], int states = 2);
+
+    /**
+     * @brief 解析 Larger than Life 规则字符串
+     *
+     * 逗号分隔的字段 (顺序不限，大小写不敏感)：
+     * Rn 半径 (1 - 10)，Cn 状态数 (0 与 2 都表示两态)，Mn 是否计入中心 (0/1)，
+     * Sa..b 存活区间，Ba..b 出生区间，NM / NN 正方形 / 菱形邻域 (默认 NM)。
+     *
+     * @param outRule 输出的 LtL 参数
+     * @param outStates 输出的状态数
+     * @return false 不是 LtL 记法或参数越界
+     */
+    bool ParseLtlRule(const std::string &ruleStr, LtlRule &outRule, int &outStates);
+
+    /**
+     * @brief 把 LtL 参数编译为预编译规则
+     *
+     * 半径 1 的 Moore 邻域规则折算为普通转移掩码 (走位并行内核)，其余情况保留 LtL 参数。
+     */
+    static CompiledRule CompileLtlRule(const LtlRule &ltl, int states = 2);
+
+    /**
+     * @brief 把出生/存活集合编译为转移表
+     *
+     * 生成 18 位转移掩码，并据此填充 512 项的 3x3 邻域表。
+     * 超出 0-8 范围的邻居数会被忽略。
+     *
+     * @param birth 出生集合
+     * @param survival 存活集合
+     * @param states 状态数 (默认 2，即普通 B/S 规则)
+     * @return CompiledRule 编译结果
+     */
+    static CompiledRule CompileRule(const std::set<int> &birth, const std::set<int> &survival, int states = 2);
+
+    /**
+     * @brief 获取预编译规则
+     *
+     * 返回的指针在添加新规则前有效，长期持有请拷贝一份。
+     * @param index 规则索引
+     * @return const CompiledRule* 预编译规则，索引无效时返回 nullptr
+     */
+    const CompiledRule *GetCompiledRule(int index) const;
+
+    /**
+     * @brief 添加自定义规则
+     *
+     * 解析规则字符串并编译，与内置规则一样加入规则列表。
+     * @param name 规则名称
+     * @param ruleStr 规则字符串 (例如 "B36/S23"、"B2/S345/C4")
+     * @return int 新规则的索引，规则字符串无效时返回 -1 (不添加)
+     */
+    int AddCustomRule(const std::wstring &name, const std::string &ruleStr);
+
+    /**
+     * @brief 按规则字符串查找规则 (比较解析后的出生/存活/状态数，而不是字符串本身)
+     * @return int 规则索引，找不到时返回 -1
+     */
+    int FindRule(const std::string &ruleStr);
+
     /**
      * @brief 计算下一个状态
      * 
      * 根据当前状态、邻居数量和指定规则计算细胞的下一代状态。
+     * 通过预编译的转移掩码查表，不做集合查找。
      * 
      * @param currentState 当前细胞状态 (true=活, false=死)
      * @param neighbors 活邻居数量
@@ -81,5 +179,11 @@ private:
      */
     void InitBuiltinRules();
 
+    /**
+     * @brief 解析任意支持的记法，填充 RuleData 的集合、状态数与预编译规则
+     * @return false 规则字符串无效
+     */
+    bool BuildRule(const std::string &ruleStr, RuleData &out);
+
     std::vector<RuleData> m_rules; ///< 存储所有规则
 };
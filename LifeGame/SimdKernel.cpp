@@ -0,0 +1,196 @@
+#include "SimdKernel.h"
+#include "BitOps.h"
+#include "SimdKernelImpl.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define LIFEGAME_X86_MSVC 1
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIFEGAME_X86_GNUC 1
+#endif
+
+// ==========================================
+// 标量实现 (Scalar Fallback)
+// ==========================================
+
+static long long CountBitsScalar(const uint64_t *words, int count) {
+    long long total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += PopCount64(words[i]);
+    }
+    return total;
+}
+
+static uint64_t AccumulateCountsScalar(const uint64_t *before, const uint64_t *after, int count,
+                                       CellCounts &counts) {
+    uint64_t diff = 0;
+    for (int i = 0; i < count; ++i) {
+        diff |= before[i] ^ after[i];
+        AccumulateCellCounts(before[i], after[i], counts);
+    }
+    return diff;
+}
+
+static void InvertWordsScalar(uint64_t *words, int count) {
+    for (int i = 0; i < count; ++i) {
+        words[i] = ~words[i];
+    }
+}
+
+const KernelTable *GetScalarKernelTable() {
+    // 特化内核同样走 StepRowSimd，标量操作集一次处理 1 个字
+    static const KernelTable table = {
+        SimdLevel::Scalar, "Scalar", StepRowSwar, StepRowLut, CountBitsScalar, AccumulateCountsScalar,
+        InvertWordsScalar, MakeSpecializedKernels<ScalarOps>(), BUILTIN_RULE_MASK_COUNT
+    };
+    return &table;
+}
+
+/**
+ * @brief 为规则选择行内核
+ *
+ * 只在切换规则或指令集时调用，线性查找即可。
+ */
+StepRowFn SelectStepRow(const KernelTable &table, const CompiledRule &rule) {
+    if (rule.IsNonTotalistic()) return table.stepRowLut;
+    for (int i = 0; i < table.specializedCount; ++i) {
+        if (table.specialized[i].transitions == rule.transitions) {
+            return table.specialized[i].stepRow;
+        }
+    }
+    return table.stepRow;
+}
+
+/**
+ * @brief 计算一段行的下一代
+ */
+void StepGridRows(StepRowFn stepRow, const BitGrid &src, BitGrid &dst, int firstRow, int lastRow,
+                  const BoundaryHalo &halo, const CompiledRule &rule) {
+    StepGridTile(GetActiveKernelTable(), stepRow, src, dst, firstRow, lastRow, 0, src.GetWordsPerRow(), halo, rule);
+}
+
+/**
+ * @brief 计算一个分块的下一代
+ *
+ * 首行、末行的上下邻行直接换成幽灵行，行首、行尾的左右邻居由幽灵列补入，没有任何取模。
+ * 每行算完后立即与当前代比较 (数据仍在缓存中)，得到分块是否变化；
+ * 需要细胞计数时在同一个循环里 popcount，不再单独扫描棋盘 (CPU 支持时使用 POPCNT 指令，见 KernelTable::accumulateCounts)。
+ */
+bool StepGridTile(const KernelTable &kernels, StepRowFn stepRow, const BitGrid &src, BitGrid &dst, int firstRow,
+                  int lastRow, int firstWord, int lastWord, const BoundaryHalo &halo, const CompiledRule &rule,
+                  CellCounts *counts) {
+    const int width = src.GetWidth();
+    const int wordsPerRow = src.GetWordsPerRow();
+    const uint64_t lastWordMask = src.GetLastWordMask();
+    if (counts != nullptr) *counts = CellCounts();
+    uint64_t diff = 0;
+    for (int y = firstRow; y < lastRow; y++) {
+        const uint64_t *above = halo.GetAbove(src, y);
+        const uint64_t *below = halo.GetBelow(src, y);
+        const uint64_t *row = src.GetRow(y);
+        uint64_t *out = dst.GetRow(y);
+        stepRow(above, row, below, out, firstWord, lastWord, wordsPerRow, width, lastWordMask,
+                halo.GetGhosts(y), rule);
+        if (counts != nullptr) {
+            diff |= kernels.accumulateCounts(row + firstWord, out + firstWord, lastWord - firstWord, *counts);
+        } else {
+            for (int i = firstWord; i < lastWord; i++) {
+                diff |= row[i] ^ out[i];
+            }
+        }
+    }
+    return diff != 0;
+}
+
+/**
+ * @brief 计算 Generations 规则下一个分块的下一代
+ *
+ * 活细胞位平面与状态一一对应，比较状态即可得到分块是否变化。
+ */
+bool StepGenerationsTile(const KernelTable &kernels, StepRowFn stepRow, const BitGrid &src, BitGrid &dst,
+                         const StateGrid &srcStates, StateGrid &dstStates, int firstRow, int lastRow,
+                         int firstWord, int lastWord, const BoundaryHalo &halo, const CompiledRule &rule,
+                         CellCounts *counts) {
+    const int width = src.GetWidth();
+    const int wordsPerRow = src.GetWordsPerRow();
+    const uint64_t lastWordMask = src.GetLastWordMask();
+    if (counts != nullptr) *counts = CellCounts();
+    bool changed = false;
+    for (int y = firstRow; y < lastRow; y++) {
+        const uint64_t *row = src.GetRow(y);
+        uint64_t *out = dst.GetRow(y);
+        stepRow(halo.GetAbove(src, y), row, halo.GetBelow(src, y), out, firstWord, lastWord,
+                wordsPerRow, width, lastWordMask, halo.GetGhosts(y), rule);
+        if (ApplyDecayRow(srcStates.GetRow(y), dstStates.GetRow(y), out, firstWord, lastWord, width, rule.states)) {
+            changed = true;
+        }
+        // 衰减态屏蔽出生之后的位平面才是下一代的活细胞
+        if (counts != nullptr) {
+            kernels.accumulateCounts(row + firstWord, out + firstWord, lastWord - firstWord, *counts);
+        }
+    }
+    return changed;
+}
+
+// ==========================================
+// CPU 检测与分派 (CPU Detection & Dispatch)
+// ==========================================
+
+/**
+ * @brief 检测 CPU 支持的 SIMD 级别
+ *
+ * AVX2 除了需要 CPUID 标志位，还要求操作系统通过 XSAVE 保存 YMM 寄存器 (XCR0 的第 1、2 位)，
+ * 否则即使 CPU 支持，执行 AVX 指令也会触发非法指令异常。
+ * AVX2 编译单元的细胞计数使用 POPCNT 指令，因此同时要求 POPCNT 标志位 (支持 AVX2 的 CPU 实际上都有)。
+ */
+SimdLevel DetectSimdLevel() {
+#if defined(LIFEGAME_X86_MSVC)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse2 = ((info[3] >> 26) & 1) != 0;
+    const bool osxsave = ((info[2] >> 27) & 1) != 0;
+    const bool avx = ((info[2] >> 28) & 1) != 0;
+    const bool popcnt = ((info[2] >> 23) & 1) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx) {
+        const unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = ((info[1] >> 5) & 1) != 0;
+        }
+    }
+    if (avx2 && popcnt && GetAvx2KernelTable()) return SimdLevel::AVX2;
+    if (sse2 && GetSse2KernelTable()) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#elif defined(LIFEGAME_X86_GNUC)
+    // GCC/Clang 的内建检测同样会检查操作系统是否启用了 AVX 状态保存
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt") && GetAvx2KernelTable()) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2") && GetSse2KernelTable()) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const KernelTable *GetKernelTable(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return GetAvx2KernelTable();
+        case SimdLevel::SSE2: return GetSse2KernelTable();
+        case SimdLevel::Scalar: return GetScalarKernelTable();
+    }
+    return GetScalarKernelTable();
+}
+
+const KernelTable &GetActiveKernelTable() {
+    // 局部静态变量：第一次调用时检测一次，之后直接返回 (C++11 起初始化是线程安全的)
+    static const KernelTable *active = GetKernelTable(DetectSimdLevel());
+    return *active;
+}
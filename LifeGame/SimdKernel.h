@@ -0,0 +1,158 @@
+#pragma once
+#include <cstdint>
+#include "LifeKernel.h"
+#include "Topology.h"
+#include "StateGrid.h"
+
+struct CellCounts;
+
+/**
+ * @brief SIMD 指令集级别
+ */
+enum class SimdLevel {
+    Scalar = 0, ///< 可移植标量实现 (每次 64 细胞)
+    SSE2 = 1, ///< 128 位 SSE2 实现 (每次 128 细胞)
+    AVX2 = 2 ///< 256 位 AVX2 实现 (每次 256 细胞)
+};
+
+/**
+ * @brief 行内核函数指针 (参数含义同 StepRowSwar)
+ *
+ * 计算一行中 [firstWord, lastWord) 范围内的字，整行或分块都使用同一个内核。
+ */
+typedef void (*StepRowFn)(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                          int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                          GhostCells ghosts, const CompiledRule &rule);
+
+/**
+ * @brief 某条规则的特化行内核
+ *
+ * 出生/存活掩码在编译期固定，规则求值被折叠成最简布尔表达式。
+ */
+struct SpecializedKernel {
+    uint32_t transitions; ///< 对应规则的转移掩码 (CompiledRule::transitions)
+    StepRowFn stepRow; ///< 特化行内核
+};
+
+/**
+ * @brief 演化内核函数表
+ *
+ * 同一组操作的某一指令集实现。程序启动时根据 CPUID 选出当前 CPU 支持的最高级别，
+ * 之后所有调用都通过函数指针完成，因此同一个可执行文件可以在新旧 CPU 上都全速运行。
+ */
+struct KernelTable {
+    SimdLevel level; ///< 指令集级别
+    const char *name; ///< 可读名称 (例如 "AVX2")
+
+    /**
+     * @brief 计算一整行的下一代 (通用内核，适用于任意 B/S 规则)
+     */
+    StepRowFn stepRow;
+
+    /**
+     * @brief 计算一整行的下一代 (非全和规则，对 CompiledRule::network 按位并行求值)
+     */
+    StepRowFn stepRowLut;
+
+    /**
+     * @brief 统计连续 count 个字中置 1 的位数
+     */
+    long long (*countBits)(const uint64_t *words, int count);
+
+    /**
+     * @brief 比较连续 count 个字的前后两代，计入细胞计数 (出生、死亡与下一代人口)
+     * @return uint64_t 各字前后差异的按位或，为 0 表示没有变化
+     */
+    uint64_t (*accumulateCounts)(const uint64_t *before, const uint64_t *after, int count, CellCounts &counts);
+
+    /**
+     * @brief 按位取反连续 count 个字 (不处理填充位)
+     */
+    void (*invertWords)(uint64_t *words, int count);
+
+    const SpecializedKernel *specialized; ///< 内置规则的特化内核
+    int specializedCount; ///< 特化内核数量
+};
+
+/**
+ * @brief 为规则选择行内核
+ *
+ * 非全和规则返回该函数表的邻域表内核 (stepRowLut)；
+ * 转移掩码与某个内置规则相同时返回其特化内核，否则返回通用内核。
+ * @param table 函数表
+ * @param rule 预编译规则
+ * @return StepRowFn 行内核
+ */
+StepRowFn SelectStepRow(const KernelTable &table, const CompiledRule &rule);
+
+/**
+ * @brief 计算 [firstRow, lastRow) 各行的下一代
+ *
+ * 只读 src、只写 dst 中的这些行，因此不同行区间可以在不同线程上同时计算，
+ * 区间边界处的上下邻行 (Halo) 直接从 src 读取，网格外一圈取自 halo。
+ * @param stepRow 行内核
+ * @param src 当前代网格
+ * @param dst 下一代网格 (尺寸与 src 相同)
+ * @param firstRow 起始行
+ * @param lastRow 结束行 (不含)
+ * @param halo 已按 src 刷新的幽灵细胞 (决定边界拓扑)
+ * @param rule 预编译规则
+ */
+void StepGridRows(StepRowFn stepRow, const BitGrid &src, BitGrid &dst, int firstRow, int lastRow,
+                  const BoundaryHalo &halo, const CompiledRule &rule);
+
+/**
+ * @brief 计算一个矩形分块 (行 [firstRow, lastRow) x 字 [firstWord, lastWord)) 的下一代
+ *
+ * 只写 dst 中这块区域的字，左右、上下的邻居 (Halo) 从 src 读取，网格外一圈取自 halo，
+ * 因此互不重叠的分块可以在任意线程上以任意顺序计算。
+ * @param kernels 细胞计数使用的函数表 (与选出 stepRow 的函数表一致)
+ * @param counts 非空时在同一遍中统计该区域下一代的活细胞数与出生/死亡数
+ * @return bool 该区域的下一代是否与当前代不同
+ */
+bool StepGridTile(const KernelTable &kernels, StepRowFn stepRow, const BitGrid &src, BitGrid &dst, int firstRow,
+                  int lastRow, int firstWord, int lastWord, const BoundaryHalo &halo, const CompiledRule &rule,
+                  CellCounts *counts = nullptr);
+
+/**
+ * @brief 计算 Generations 规则下一个矩形分块的下一代
+ *
+ * 先用行内核 (只统计状态 1 的邻居，与两态规则完全相同) 算出出生/存活，
+ * 再用 ApplyDecayRow 推进衰减态并屏蔽衰减细胞上的出生。
+ * 分块的读写范围与 StepGridTile 相同，两个平面一起双缓冲。
+ * @param kernels 细胞计数使用的函数表
+ * @param counts 非空时统计状态 1 (活细胞位平面) 的人口与出生/死亡数
+ * @return bool 该区域的状态是否与当前代不同
+ */
+bool StepGenerationsTile(const KernelTable &kernels, StepRowFn stepRow, const BitGrid &src, BitGrid &dst,
+                         const StateGrid &srcStates, StateGrid &dstStates, int firstRow, int lastRow,
+                         int firstWord, int lastWord, const BoundaryHalo &halo, const CompiledRule &rule,
+                         CellCounts *counts = nullptr);
+
+/**
+ * @brief 检测当前 CPU (及操作系统) 支持的最高 SIMD 级别
+ */
+SimdLevel DetectSimdLevel();
+
+/**
+ * @brief 获取指定级别的函数表
+ *
+ * 如果该级别没有被编译进来 (例如非 x86 平台)，返回 nullptr。
+ * 调用方需保证 level 不高于 DetectSimdLevel() 的结果。
+ */
+const KernelTable *GetKernelTable(SimdLevel level);
+
+/**
+ * @brief 获取当前 CPU 可用的最佳函数表
+ *
+ * 第一次调用时执行 CPUID 检测，结果在进程内缓存。
+ */
+const KernelTable &GetActiveKernelTable();
+
+// 各指令集实现的函数表 (分别定义在独立的编译单元中，以便单独设置编译选项)
+// 注意：AVX2 编译单元整体以 AVX2 代码生成，只能在确认 CPU 支持后再调用 GetAvx2KernelTable()
+const KernelTable *GetScalarKernelTable();
+
+const KernelTable *GetSse2KernelTable();
+
+const KernelTable *GetAvx2KernelTable();
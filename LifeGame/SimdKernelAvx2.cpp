@@ -0,0 +1,137 @@
+#include "SimdKernel.h"
+#include "BitOps.h"
+
+// 本文件需要以 AVX2 与 POPCNT 代码生成选项编译 (GCC/Clang: -mavx2 -mpopcnt，见 CMakeLists.txt)；
+// MSVC 不需要额外选项即可使用 AVX2 与 POPCNT intrinsics。
+// 只有在运行时检测到 AVX2 与 POPCNT 后才会调用这里的函数。
+#if (defined(__AVX2__) && defined(__POPCNT__)) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define LIFEGAME_HAS_AVX2 1
+#include <immintrin.h>
+#include "SimdKernelImpl.h"
+
+// 操作集与内核放在匿名命名空间中：模板实例化只在本编译单元内可见，
+// 避免以 AVX2 生成的代码被链接器合并给其它编译单元使用
+namespace {
+    /**
+     * @brief AVX2 操作集：一次处理 4 个 64 位字 (256 细胞)
+     */
+    struct Avx2Ops {
+        typedef __m256i V;
+        static constexpr int LANES = 4;
+
+        static V LoadU(const uint64_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+        static void StoreU(uint64_t *p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+        static V And(V a, V b) { return _mm256_and_si256(a, b); }
+        static V Or(V a, V b) { return _mm256_or_si256(a, b); }
+        static V Xor(V a, V b) { return _mm256_xor_si256(a, b); }
+        static V Not(V a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+        static V Zero() { return _mm256_setzero_si256(); }
+        static V Shl1(V a) { return _mm256_slli_epi64(a, 1); }
+        static V Shr1(V a) { return _mm256_srli_epi64(a, 1); }
+        static V Shl63(V a) { return _mm256_slli_epi64(a, 63); }
+        static V Shr63(V a) { return _mm256_srli_epi64(a, 63); }
+    };
+
+    void StepRowAvx2(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                     int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                     GhostCells ghosts, const CompiledRule &rule) {
+        StepRowSimd<Avx2Ops, RuntimeRule>(above, row, below, out, firstWord, lastWord, wordsPerRow, width,
+                                        lastWordMask, ghosts, rule);
+    }
+
+    void StepRowLutAvx2(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                        int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                        GhostCells ghosts, const CompiledRule &rule) {
+        StepRowLutSimd<Avx2Ops>(above, row, below, out, firstWord, lastWord, wordsPerRow, width, lastWordMask,
+                                ghosts, rule);
+    }
+
+    /**
+     * @brief AVX2 popcount (半字节查表法)
+     *
+     * 用 vpshufb 对每个字节的高低 4 位查表得到位数，再用 vpsadbw 横向累加。
+     */
+    long long CountBitsAvx2(const uint64_t *words, int count) {
+        const __m256i lookup = _mm256_setr_epi8(
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i lowMask = _mm256_set1_epi8(0x0F);
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i acc = _mm256_setzero_si256();
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            const __m256i lo = _mm256_and_si256(v, lowMask);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+            const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, zero));
+        }
+
+        uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), acc);
+        long long total = static_cast<long long>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+        if (i < count) {
+            total += GetScalarKernelTable()->countBits(words + i, count - i);
+        }
+        return total;
+    }
+
+    /**
+     * @brief POPCNT 指令统计 64 位字中置 1 的位数
+     */
+    inline long long PopCountHardware(uint64_t v) {
+#if defined(_M_X64) || defined(__x86_64__)
+        return static_cast<long long>(_mm_popcnt_u64(v));
+#else
+        return _mm_popcnt_u32(static_cast<uint32_t>(v)) + _mm_popcnt_u32(static_cast<uint32_t>(v >> 32));
+#endif
+    }
+
+    /**
+     * @brief 细胞计数 (POPCNT 指令)
+     *
+     * 与标量版本的分支相同：空白字与未变化的字只做一次或零次 popcount。
+     */
+    uint64_t AccumulateCountsAvx2(const uint64_t *before, const uint64_t *after, int count, CellCounts &counts) {
+        uint64_t diff = 0;
+        for (int i = 0; i < count; ++i) {
+            const uint64_t b = before[i];
+            const uint64_t a = after[i];
+            diff |= a ^ b;
+            if (a == b) {
+                if (a != 0) counts.population += PopCountHardware(a);
+                continue;
+            }
+            counts.population += PopCountHardware(a);
+            counts.births += PopCountHardware(a & ~b);
+            counts.deaths += PopCountHardware(b & ~a);
+        }
+        return diff;
+    }
+
+    void InvertWordsAvx2(uint64_t *words, int count) {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i *p = reinterpret_cast<__m256i *>(words + i);
+            _mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p), ones));
+        }
+        for (; i < count; ++i) {
+            words[i] = ~words[i];
+        }
+    }
+}
+#endif
+
+const KernelTable *GetAvx2KernelTable() {
+#if defined(LIFEGAME_HAS_AVX2)
+    static const KernelTable table = {
+        SimdLevel::AVX2, "AVX2", StepRowAvx2, StepRowLutAvx2, CountBitsAvx2, AccumulateCountsAvx2,
+        InvertWordsAvx2, MakeSpecializedKernels<Avx2Ops>(), BUILTIN_RULE_MASK_COUNT
+    };
+    return &table;
+#else
+    return nullptr;
+#endif
+}
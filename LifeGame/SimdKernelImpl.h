@@ -0,0 +1,177 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include "LifeKernel.h"
+#include "SimdKernel.h"
+
+/**
+ * @brief SIMD 行内核的通用实现
+ *
+ * 仅供各指令集的内核编译单元 (SimdKernel*.cpp) 包含，Ops 为该编译单元使用的向量操作集，
+ * Rule 为 RuntimeRule (通用内核) 或 StaticRule (内置规则的特化内核)。
+ *
+ * 计算一行中 [firstWord, lastWord) 范围内的字 (整行或一个分块的宽度)。
+ * 行首、行尾两个字需要补入幽灵细胞，交给标量 StepWordsSwar；
+ * 中间的字用非对齐加载一次取 Ops::LANES 个字，以及它们各自左右相邻的字，
+ * 64 位通道内移位后拼出西/东邻居平面，不需要跨通道的数据重排。
+ * 不足一个向量的余数同样交给标量实现。
+ */
+template <class Ops, class Rule>
+inline void StepRowSimd(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                        int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                        GhostCells ghosts, const CompiledRule &rule) {
+    typedef typename Ops::V V;
+    const Rule masks(rule);
+
+    int i = firstWord;
+    if (i == 0) {
+        // 行首 (含西侧幽灵细胞)
+        StepWordsSwar(above, row, below, out, 0, 1, wordsPerRow, width, ghosts, rule);
+        i = 1;
+    }
+
+    // 最后一个字含东侧幽灵细胞，单独处理
+    const int interiorEnd = lastWord < wordsPerRow - 1 ? lastWord : wordsPerRow - 1;
+    for (; i + Ops::LANES <= interiorEnd; i += Ops::LANES) {
+        const V a = Ops::LoadU(above + i);
+        const V c = Ops::LoadU(row + i);
+        const V b = Ops::LoadU(below + i);
+
+        const V aw = Ops::Or(Ops::Shl1(a), Ops::Shr63(Ops::LoadU(above + i - 1)));
+        const V ae = Ops::Or(Ops::Shr1(a), Ops::Shl63(Ops::LoadU(above + i + 1)));
+        const V cw = Ops::Or(Ops::Shl1(c), Ops::Shr63(Ops::LoadU(row + i - 1)));
+        const V ce = Ops::Or(Ops::Shr1(c), Ops::Shl63(Ops::LoadU(row + i + 1)));
+        const V bw = Ops::Or(Ops::Shl1(b), Ops::Shr63(Ops::LoadU(below + i - 1)));
+        const V be = Ops::Or(Ops::Shr1(b), Ops::Shl63(Ops::LoadU(below + i + 1)));
+
+        V s0, s1, s2, s3;
+        SumNeighbors<Ops>(aw, a, ae, cw, ce, bw, b, be, s0, s1, s2, s3);
+        Ops::StoreU(out + i, ApplyRule<Ops>(s0, s1, s2, s3, c, masks));
+    }
+
+    // 余数与行尾 (含东侧幽灵细胞)
+    if (i < lastWord) {
+        StepWordsSwar(above, row, below, out, i, lastWord, wordsPerRow, width, ghosts, rule);
+    }
+    if (lastWord == wordsPerRow) {
+        out[wordsPerRow - 1] &= lastWordMask;
+    }
+}
+
+/**
+ * @brief 非全和规则的 SIMD 行内核
+ *
+ * 与 StepRowSimd 相同地取出 9 个邻居平面，再对 rule.network 求值，一次得到 Ops::LANES 个字；
+ * 行首、行尾与余数交给标量 StepWordsLut。邻域网络未生成时整行退回逐细胞查表的 StepRowLut。
+ */
+template <class Ops>
+inline void StepRowLutSimd(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                           int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                           GhostCells ghosts, const CompiledRule &rule) {
+    typedef typename Ops::V V;
+    if (!rule.network.built) {
+        StepRowLut(above, row, below, out, firstWord, lastWord, wordsPerRow, width, lastWordMask, ghosts, rule);
+        return;
+    }
+
+    int i = firstWord;
+    if (i == 0) {
+        StepWordsLut(above, row, below, out, 0, 1, wordsPerRow, width, ghosts, rule);
+        i = 1;
+    }
+
+    const int interiorEnd = lastWord < wordsPerRow - 1 ? lastWord : wordsPerRow - 1;
+    for (; i + Ops::LANES <= interiorEnd; i += Ops::LANES) {
+        const V a = Ops::LoadU(above + i);
+        const V c = Ops::LoadU(row + i);
+        const V b = Ops::LoadU(below + i);
+
+        // 下标位布局：西北、北、东北、西、中心、东、西南、南、东南
+        const V planes[9] = {
+            Ops::Or(Ops::Shl1(a), Ops::Shr63(Ops::LoadU(above + i - 1))), a,
+            Ops::Or(Ops::Shr1(a), Ops::Shl63(Ops::LoadU(above + i + 1))),
+            Ops::Or(Ops::Shl1(c), Ops::Shr63(Ops::LoadU(row + i - 1))), c,
+            Ops::Or(Ops::Shr1(c), Ops::Shl63(Ops::LoadU(row + i + 1))),
+            Ops::Or(Ops::Shl1(b), Ops::Shr63(Ops::LoadU(below + i - 1))), b,
+            Ops::Or(Ops::Shr1(b), Ops::Shl63(Ops::LoadU(below + i + 1)))
+        };
+        Ops::StoreU(out + i, EvalNeighborhoodNetwork<Ops>(planes, rule.network));
+    }
+
+    if (i < lastWord) {
+        StepWordsLut(above, row, below, out, i, lastWord, wordsPerRow, width, ghosts, rule);
+    }
+    if (lastWord == wordsPerRow) {
+        out[wordsPerRow - 1] &= lastWordMask;
+    }
+}
+
+/**
+ * @brief 内置规则的出生/存活掩码
+ */
+struct BuiltinRuleMasks {
+    uint16_t birth; ///< 出生掩码 (第 n 位表示 n 个邻居时出生)
+    uint16_t survival; ///< 存活掩码
+};
+
+/**
+ * @brief 需要生成特化内核的规则 (与 RuleEngine::InitBuiltinRules 中的内置规则一一对应)
+ *
+ * 这里只决定为哪些掩码组合生成代码，运行时按转移掩码匹配。
+ * 即使与内置规则列表不同步，也只是退回通用内核，结果不受影响。
+ */
+constexpr BuiltinRuleMasks BUILTIN_RULE_MASKS[] = {
+    {0x008, 0x00C}, // B3/S23 (Conway)
+    {0x048, 0x00C}, // B36/S23 (HighLife)
+    {0x1C8, 0x1D8}, // B3678/S34678 (Day & Night)
+    {0x004, 0x000}, // B2/S (Seeds)
+    {0x008, 0x1FF}, // B3/S012345678 (Life without Death)
+    {0x018, 0x018}, // B34/S34 (34 Life)
+    {0x1E8, 0x1E0}, // B35678/S5678 (Diamoeba)
+    {0x048, 0x026}, // B36/S125 (2x2)
+    {0x148, 0x034}, // B368/S245 (Morley)
+    {0x1D0, 0x1E8}, // B4678/S35678 (Anneal)
+    {0x008, 0x03E}, // B3/S12345 (Maze)
+    {0x088, 0x03E}, // B37/S12345 (Maze 2)
+    {0x008, 0x1F0}, // B3/S45678 (Coral)
+    {0x002, 0x002}, // B1/S1 (Gnarl)
+    {0x0AA, 0x0AA}, // B1357/S1357 (Replicator)
+    {0x0AA, 0x155}, // B1357/S02468 (Fredkin)
+    {0x144, 0x034}, // B268/S245 (Move)
+    {0x038, 0x0F0}, // B345/S4567 (Assimilation)
+    {0x188, 0x1EC}, // B378/S235678 (Coagulations)
+    {0x1F0, 0x03C}, // B45678/S2345 (Walled Cities)
+};
+
+constexpr int BUILTIN_RULE_MASK_COUNT = static_cast<int>(sizeof(BUILTIN_RULE_MASKS) / sizeof(BUILTIN_RULE_MASKS[0]));
+
+/**
+ * @brief 第 I 条内置规则的特化行内核
+ */
+template <class Ops, std::size_t I>
+void StepRowBuiltin(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                    int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                    GhostCells ghosts, const CompiledRule &rule) {
+    StepRowSimd<Ops, StaticRule<BUILTIN_RULE_MASKS[I].birth, BUILTIN_RULE_MASKS[I].survival> >(
+        above, row, below, out, firstWord, lastWord, wordsPerRow, width, lastWordMask, ghosts, rule);
+}
+
+/**
+ * @brief 为全部内置规则实例化特化内核，生成按转移掩码查找的表
+ */
+template <class Ops, std::size_t... I>
+const SpecializedKernel *MakeSpecializedKernels(std::index_sequence<I...>) {
+    static const SpecializedKernel kernels[] = {
+        {
+            static_cast<uint32_t>(BUILTIN_RULE_MASKS[I].birth) |
+            (static_cast<uint32_t>(BUILTIN_RULE_MASKS[I].survival) << CompiledRule::SURVIVAL_SHIFT),
+            &StepRowBuiltin<Ops, I>
+        }...
+    };
+    return kernels;
+}
+
+template <class Ops>
+const SpecializedKernel *MakeSpecializedKernels() {
+    return MakeSpecializedKernels<Ops>(std::make_index_sequence<BUILTIN_RULE_MASK_COUNT>());
+}
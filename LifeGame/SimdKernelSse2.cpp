@@ -0,0 +1,109 @@
+#include "SimdKernel.h"
+#include "BitOps.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define LIFEGAME_HAS_SSE2 1
+#include <emmintrin.h>
+#include "SimdKernelImpl.h"
+
+// 操作集放在匿名命名空间中，保证模板实例化只在本编译单元内可见
+namespace {
+    /**
+     * @brief SSE2 操作集：一次处理 2 个 64 位字 (128 细胞)
+     */
+    struct Sse2Ops {
+        typedef __m128i V;
+        static constexpr int LANES = 2;
+
+        static V LoadU(const uint64_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+        static void StoreU(uint64_t *p, V v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+        static V And(V a, V b) { return _mm_and_si128(a, b); }
+        static V Or(V a, V b) { return _mm_or_si128(a, b); }
+        static V Xor(V a, V b) { return _mm_xor_si128(a, b); }
+        static V Not(V a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+        static V Zero() { return _mm_setzero_si128(); }
+        static V Shl1(V a) { return _mm_slli_epi64(a, 1); }
+        static V Shr1(V a) { return _mm_srli_epi64(a, 1); }
+        static V Shl63(V a) { return _mm_slli_epi64(a, 63); }
+        static V Shr63(V a) { return _mm_srli_epi64(a, 63); }
+    };
+
+    void StepRowSse2(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                     int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                     GhostCells ghosts, const CompiledRule &rule) {
+        StepRowSimd<Sse2Ops, RuntimeRule>(above, row, below, out, firstWord, lastWord, wordsPerRow, width,
+                                        lastWordMask, ghosts, rule);
+    }
+
+    void StepRowLutSse2(const uint64_t *above, const uint64_t *row, const uint64_t *below, uint64_t *out,
+                        int firstWord, int lastWord, int wordsPerRow, int width, uint64_t lastWordMask,
+                        GhostCells ghosts, const CompiledRule &rule) {
+        StepRowLutSimd<Sse2Ops>(above, row, below, out, firstWord, lastWord, wordsPerRow, width, lastWordMask,
+                                ghosts, rule);
+    }
+
+    /**
+     * @brief SSE2 popcount
+     *
+     * SSE2 没有字节查表指令 (pshufb)，因此在每个字节内做 SWAR 计数，
+     * 再用 psadbw 把 8 个字节的计数横向累加到 64 位通道。
+     */
+    long long CountBitsSse2(const uint64_t *words, int count) {
+        const __m128i m1 = _mm_set1_epi8(0x55);
+        const __m128i m2 = _mm_set1_epi8(0x33);
+        const __m128i m4 = _mm_set1_epi8(0x0F);
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i));
+            v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi64(v, 1), m1));
+            v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi64(v, 2), m2));
+            v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi64(v, 4)), m4);
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+        }
+
+        uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        long long total = static_cast<long long>(lanes[0] + lanes[1]);
+        if (i < count) {
+            total += GetScalarKernelTable()->countBits(words + i, count - i);
+        }
+        return total;
+    }
+
+    /**
+     * @brief 细胞计数
+     *
+     * 支持 SSE2 的 CPU 不一定有 POPCNT 指令，沿用标量的 SWAR 实现。
+     */
+    uint64_t AccumulateCountsSse2(const uint64_t *before, const uint64_t *after, int count, CellCounts &counts) {
+        return GetScalarKernelTable()->accumulateCounts(before, after, count, counts);
+    }
+
+    void InvertWordsSse2(uint64_t *words, int count) {
+        const __m128i ones = _mm_set1_epi32(-1);
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i *p = reinterpret_cast<__m128i *>(words + i);
+            _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), ones));
+        }
+        for (; i < count; ++i) {
+            words[i] = ~words[i];
+        }
+    }
+}
+#endif
+
+const KernelTable *GetSse2KernelTable() {
+#if defined(LIFEGAME_HAS_SSE2)
+    static const KernelTable table = {
+        SimdLevel::SSE2, "SSE2", StepRowSse2, StepRowLutSse2, CountBitsSse2, AccumulateCountsSse2,
+        InvertWordsSse2, MakeSpecializedKernels<Sse2Ops>(), BUILTIN_RULE_MASK_COUNT
+    };
+    return &table;
+#else
+    return nullptr;
+#endif
+}
@@ -0,0 +1,50 @@
+#include "SlidingWindow.h"
+
+SlidingWindow::SlidingWindow(size_t capacity) : m_pushed(0), m_sum(0), m_capacity(capacity > 0 ? capacity : 1) {
+}
+
+void SlidingWindow::SetCapacity(size_t capacity) {
+    m_capacity = capacity > 0 ? capacity : 1;
+    while (m_values.size() > m_capacity) {
+        PopFront();
+    }
+}
+
+void SlidingWindow::Clear() {
+    m_values.clear();
+    m_maxQueue.clear();
+    m_minQueue.clear();
+    m_pushed = 0;
+    m_sum = 0;
+}
+
+void SlidingWindow::Push(long long value) {
+    if (m_values.size() == m_capacity) {
+        PopFront();
+    }
+    // 被新值 "压住" 的候选再也不会成为最值，从队尾移除
+    while (!m_maxQueue.empty() && ValueAt(m_maxQueue.back()) <= value) {
+        m_maxQueue.pop_back();
+    }
+    while (!m_minQueue.empty() && ValueAt(m_minQueue.back()) >= value) {
+        m_minQueue.pop_back();
+    }
+    m_values.push_back(value);
+    m_maxQueue.push_back(m_pushed);
+    m_minQueue.push_back(m_pushed);
+    m_pushed++;
+    m_sum += value;
+}
+
+void SlidingWindow::PopFront() {
+    const long long oldest = m_pushed - static_cast<long long>(m_values.size());
+    if (m_maxQueue.front() == oldest) m_maxQueue.pop_front();
+    if (m_minQueue.front() == oldest) m_minQueue.pop_front();
+    m_sum -= m_values.front();
+    m_values.pop_front();
+}
+
+double SlidingWindow::GetMean() const {
+    if (m_values.empty()) return 0.0;
+    return static_cast<double>(m_sum) / static_cast<double>(m_values.size());
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+
+/**
+ * @brief 滑动窗口统计
+ *
+ * 保存最近 capacity 个值，并在 O(1) 时间内给出窗口内的最小值、最大值与平均值。
+ *
+ * 最大值用单调队列维护：队列中按进入顺序保存候选值的序号，对应的值严格递减。
+ * 新值进入时先从队尾弹出所有不大于它的候选 (它们在新值离开窗口之前都不可能成为最大值)，
+ * 窗口最老的值离开时若正是队首就一并弹出，队首始终是窗口最大值。最小值对称处理。
+ * 每个值最多进出队列各一次，均摊 O(1)，与窗口长度无关；平均值由累加和得到。
+ */
+class SlidingWindow {
+public:
+    /**
+     * @param capacity 窗口长度 (至少为 1)
+     */
+    explicit SlidingWindow(size_t capacity);
+
+    /**
+     * @brief 修改窗口长度，超出新长度的最老数据被丢弃
+     */
+    void SetCapacity(size_t capacity);
+
+    size_t GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief 清空窗口 (保留窗口长度)
+     */
+    void Clear();
+
+    /**
+     * @brief 追加一个值，窗口已满时最老的值离开窗口
+     */
+    void Push(long long value);
+
+    /**
+     * @brief 窗口内的值 (从旧到新)
+     */
+    const std::deque<long long> &GetValues() const { return m_values; }
+
+    size_t GetSize() const { return m_values.size(); }
+
+    /**
+     * @brief 窗口最小值 (窗口为空时为 0)
+     */
+    long long GetMin() const { return m_minQueue.empty() ? 0 : ValueAt(m_minQueue.front()); }
+
+    /**
+     * @brief 窗口最大值 (窗口为空时为 0)
+     */
+    long long GetMax() const { return m_maxQueue.empty() ? 0 : ValueAt(m_maxQueue.front()); }
+
+    /**
+     * @brief 窗口平均值 (窗口为空时为 0)
+     */
+    double GetMean() const;
+
+    long long GetSum() const { return m_sum; }
+
+private:
+    /**
+     * @brief 移出窗口最老的值
+     */
+    void PopFront();
+
+    /**
+     * @brief 按序号取窗口中的值
+     */
+    long long ValueAt(long long sequence) const {
+        return m_values[static_cast<size_t>(sequence - (m_pushed - static_cast<long long>(m_values.size())))];
+    }
+
+    std::deque<long long> m_values; ///< 窗口内的值
+    std::deque<long long> m_maxQueue; ///< 最大值候选的序号 (对应的值严格递减)
+    std::deque<long long> m_minQueue; ///< 最小值候选的序号 (对应的值严格递增)
+    long long m_pushed; ///< 已经追加过的值的个数 (下一个值的序号)
+    long long m_sum; ///< 窗口内的值之和
+    size_t m_capacity; ///< 窗口长度
+};
@@ -0,0 +1,292 @@
+#include "SparseUniverse.h"
+#include <algorithm>
+#include <cstring>
+#include "BitOps.h"
+#include "LifeKernel.h"
+#include "RuleEngine.h"
+
+SparseUniverse::SparseUniverse()
+    : m_generation(0), m_rule(RuleEngine::CompileRule({3}, {2, 3})) {
+    memset(m_emptyTile.rows, 0, sizeof(m_emptyTile.rows));
+}
+
+SparseUniverse::~SparseUniverse() {
+}
+
+void SparseUniverse::Clear() {
+    m_tiles.clear();
+    m_spareTiles.clear();
+    m_generation = 0;
+}
+
+bool SparseUniverse::IsRuleSupported(const CompiledRule &rule) {
+    return (rule.GetBirthMask() & 1u) == 0 && !rule.IsGenerations() && !rule.IsLargerThanLife() &&
+           !rule.IsNonTotalistic();
+}
+
+bool SparseUniverse::SetRule(const CompiledRule &rule) {
+    if (!IsRuleSupported(rule)) return false;
+    m_rule = rule;
+    return true;
+}
+
+// ==========================================
+// 分块管理 (Tile Management)
+// ==========================================
+
+const SparseUniverse::TileData *SparseUniverse::FindTile(int64_t tx, int64_t ty) const {
+    const TileKey key = {tx, ty};
+    const TileMap::const_iterator it = m_tiles.find(key);
+    return it != m_tiles.end() ? it->second.get() : nullptr;
+}
+
+std::unique_ptr<SparseUniverse::TileData> SparseUniverse::AllocTile() {
+    std::unique_ptr<TileData> tile;
+    if (!m_spareTiles.empty()) {
+        tile = std::move(m_spareTiles.back());
+        m_spareTiles.pop_back();
+    } else {
+        tile.reset(new TileData);
+    }
+    memset(tile->rows, 0, sizeof(tile->rows));
+    return tile;
+}
+
+void SparseUniverse::FreeTile(std::unique_ptr<TileData> tile) {
+    // 少量备用分块避免每代反复分配；超出部分直接释放，内存跟随活区域收缩
+    if (m_spareTiles.size() < m_tiles.size()) {
+        m_spareTiles.push_back(std::move(tile));
+    }
+}
+
+// ==========================================
+// 演化 (Evolution)
+// ==========================================
+
+/**
+ * @brief 收集候选分块
+ *
+ * 活细胞最多影响距离 1 的细胞，因此只有贴着某条边 (或某个角) 的活细胞
+ * 才需要把对应方向的相邻分块加入计算。
+ */
+void SparseUniverse::CollectCandidates() {
+    m_candidates.clear();
+    for (const TileMap::value_type &entry: m_tiles) {
+        const TileKey &key = entry.first;
+        const TileData &tile = *entry.second;
+
+        uint64_t any = 0;
+        for (int r = 0; r < TILE_SIZE; ++r) {
+            any |= tile.rows[r];
+        }
+        if (!any) continue;
+        m_candidates.insert(key);
+
+        const bool north = tile.rows[0] != 0;
+        const bool south = tile.rows[TILE_SIZE - 1] != 0;
+        const bool west = (any & 1ULL) != 0;
+        const bool east = (any >> 63) != 0;
+        if (north) m_candidates.insert(TileKey{key.x, key.y - 1});
+        if (south) m_candidates.insert(TileKey{key.x, key.y + 1});
+        if (west) m_candidates.insert(TileKey{key.x - 1, key.y});
+        if (east) m_candidates.insert(TileKey{key.x + 1, key.y});
+        if (tile.rows[0] & 1ULL) m_candidates.insert(TileKey{key.x - 1, key.y - 1});
+        if (tile.rows[0] >> 63) m_candidates.insert(TileKey{key.x + 1, key.y - 1});
+        if (tile.rows[TILE_SIZE - 1] & 1ULL) m_candidates.insert(TileKey{key.x - 1, key.y + 1});
+        if (tile.rows[TILE_SIZE - 1] >> 63) m_candidates.insert(TileKey{key.x + 1, key.y + 1});
+    }
+}
+
+/**
+ * @brief 计算一个分块的下一代
+ *
+ * 与网格内核相同的全加器逻辑，只是每行只有一个字：
+ * 西/东邻居平面由本字移位后，从左右分块同一行的最高位/最低位补入。
+ */
+bool SparseUniverse::StepTile(const TileKey &key, TileData &out) const {
+    const TileData *neighbors[3][3];
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            const TileData *tile = FindTile(key.x + dx, key.y + dy);
+            neighbors[dy + 1][dx + 1] = tile ? tile : &m_emptyTile;
+        }
+    }
+
+    // 第 r 行 (r = -1 .. 64) 的 西邻居列字 / 本字 / 东邻居列字
+    auto rowOf = [&](int r, int column) -> uint64_t {
+        if (r < 0) return neighbors[0][column]->rows[TILE_SIZE - 1];
+        if (r >= TILE_SIZE) return neighbors[2][column]->rows[0];
+        return neighbors[1][column]->rows[r];
+    };
+    auto westOf = [&](int r) { return (rowOf(r, 1) << 1) | (rowOf(r, 0) >> 63); };
+    auto eastOf = [&](int r) { return (rowOf(r, 1) >> 1) | (rowOf(r, 2) << 63); };
+
+    const RuntimeRule masks(m_rule);
+    uint64_t any = 0;
+    for (int r = 0; r < TILE_SIZE; ++r) {
+        uint64_t s0, s1, s2, s3;
+        SumNeighbors<ScalarOps>(westOf(r - 1), rowOf(r - 1, 1), eastOf(r - 1),
+                                westOf(r), eastOf(r),
+                                westOf(r + 1), rowOf(r + 1, 1), eastOf(r + 1),
+                                s0, s1, s2, s3);
+        out.rows[r] = ApplyRule<ScalarOps>(s0, s1, s2, s3, rowOf(r, 1), masks);
+        any |= out.rows[r];
+    }
+    return any != 0;
+}
+
+/**
+ * @brief 推进一代
+ *
+ * 读当前分块表，写新分块表，最后交换 (双缓冲)。结果为空的分块不进入新表。
+ */
+void SparseUniverse::Step() {
+    CollectCandidates();
+
+    m_nextTiles.clear();
+    m_nextTiles.reserve(m_candidates.size());
+    for (const TileKey &key: m_candidates) {
+        std::unique_ptr<TileData> tile = AllocTile();
+        if (StepTile(key, *tile)) {
+            m_nextTiles.emplace(key, std::move(tile));
+        } else {
+            FreeTile(std::move(tile));
+        }
+    }
+
+    m_tiles.swap(m_nextTiles);
+    for (TileMap::value_type &entry: m_nextTiles) {
+        FreeTile(std::move(entry.second));
+    }
+    m_nextTiles.clear();
+    ++m_generation;
+}
+
+// ==========================================
+// 细胞访问 (Cell Access)
+// ==========================================
+
+void SparseUniverse::SetCell(int64_t x, int64_t y, bool state) {
+    const TileKey key = {TileIndex(x), TileIndex(y)};
+    const uint64_t bit = 1ULL << (x & 63);
+    const int r = static_cast<int>(y & 63);
+
+    TileMap::iterator it = m_tiles.find(key);
+    if (it == m_tiles.end()) {
+        if (!state) return;
+        it = m_tiles.emplace(key, AllocTile()).first;
+    }
+
+    if (state) {
+        it->second->rows[r] |= bit;
+    } else {
+        it->second->rows[r] &= ~bit;
+    }
+}
+
+bool SparseUniverse::GetCell(int64_t x, int64_t y) const {
+    const TileData *tile = FindTile(TileIndex(x), TileIndex(y));
+    return tile && ((tile->rows[y & 63] >> (x & 63)) & 1ULL) != 0;
+}
+
+/**
+ * @brief 读取网格一行中从第 offset 个细胞开始的 64 个细胞 (offset 可为负，越界部分为 0)
+ */
+static uint64_t ReadBits(const uint64_t *row, int wordsPerRow, int64_t offset) {
+    const int64_t q = offset >> 6;
+    const int s = static_cast<int>(offset & 63);
+    const uint64_t lo = (q >= 0 && q < wordsPerRow) ? row[q] : 0;
+    if (s == 0) return lo;
+    const uint64_t hi = (q + 1 >= 0 && q + 1 < wordsPerRow) ? row[q + 1] : 0;
+    return (lo >> s) | (hi << (64 - s));
+}
+
+/**
+ * @brief 把 64 个细胞按位或写入网格一行中从第 offset 个细胞开始的位置 (越界部分丢弃)
+ */
+static void OrBits(uint64_t *row, int wordsPerRow, int64_t offset, uint64_t bits) {
+    const int64_t q = offset >> 6;
+    const int s = static_cast<int>(offset & 63);
+    if (q >= 0 && q < wordsPerRow) row[q] |= bits << s;
+    if (s != 0 && q + 1 >= 0 && q + 1 < wordsPerRow) row[q + 1] |= bits >> (64 - s);
+}
+
+void SparseUniverse::ImportRegion(int64_t x, int64_t y, const BitGrid &grid) {
+    const int width = grid.GetWidth();
+    const int height = grid.GetHeight();
+    if (width <= 0 || height <= 0) return;
+
+    for (int64_t ty = TileIndex(y); ty <= TileIndex(y + height - 1); ++ty) {
+        for (int64_t tx = TileIndex(x); tx <= TileIndex(x + width - 1); ++tx) {
+            // 本分块内被区域覆盖的列 [lo, hi)
+            const int64_t tileX = tx * TILE_SIZE;
+            const int lo = static_cast<int>(std::max<int64_t>(x - tileX, 0));
+            const int hi = static_cast<int>(std::min<int64_t>(x + width - tileX, TILE_SIZE));
+            const uint64_t cover = (hi == TILE_SIZE ? ~0ULL : (1ULL << hi) - 1) & ~((1ULL << lo) - 1);
+
+            const TileKey key = {tx, ty};
+            TileMap::iterator it = m_tiles.find(key);
+            std::unique_ptr<TileData> fresh;
+            TileData *tile = (it != m_tiles.end()) ? it->second.get() : (fresh = AllocTile()).get();
+
+            uint64_t any = 0;
+            for (int r = 0; r < TILE_SIZE; ++r) {
+                const int64_t gy = ty * TILE_SIZE + r - y;
+                if (gy >= 0 && gy < height) {
+                    const uint64_t bits = ReadBits(grid.GetRow(static_cast<int>(gy)), grid.GetWordsPerRow(),
+                                                   tileX - x);
+                    tile->rows[r] = (tile->rows[r] & ~cover) | (bits & cover);
+                }
+                any |= tile->rows[r];
+            }
+
+            if (fresh) {
+                if (any) m_tiles.emplace(key, std::move(fresh));
+                else FreeTile(std::move(fresh));
+            } else if (!any) {
+                std::unique_ptr<TileData> empty = std::move(it->second);
+                m_tiles.erase(it);
+                FreeTile(std::move(empty));
+            }
+        }
+    }
+}
+
+void SparseUniverse::ExportRegion(int64_t x, int64_t y, BitGrid &grid) const {
+    grid.Clear();
+    const int width = grid.GetWidth();
+    const int height = grid.GetHeight();
+    if (width <= 0 || height <= 0) return;
+
+    const int64_t tx0 = TileIndex(x);
+    const int64_t tx1 = TileIndex(x + width - 1);
+    const int64_t ty0 = TileIndex(y);
+    const int64_t ty1 = TileIndex(y + height - 1);
+    for (const TileMap::value_type &entry: m_tiles) {
+        const TileKey &key = entry.first;
+        if (key.x < tx0 || key.x > tx1 || key.y < ty0 || key.y > ty1) continue;
+
+        for (int r = 0; r < TILE_SIZE; ++r) {
+            const int64_t gy = key.y * TILE_SIZE + r - y;
+            if (gy < 0 || gy >= height || !entry.second->rows[r]) continue;
+            OrBits(grid.GetRow(static_cast<int>(gy)), grid.GetWordsPerRow(), key.x * TILE_SIZE - x,
+                   entry.second->rows[r]);
+        }
+    }
+
+    // 清除写到最后一个字填充位上的细胞，维持 BitGrid 的不变量
+    const uint64_t mask = grid.GetLastWordMask();
+    for (int gy = 0; gy < height; ++gy) {
+        grid.GetRow(gy)[grid.GetWordsPerRow() - 1] &= mask;
+    }
+}
+
+uint64_t SparseUniverse::GetPopulation() const {
+    uint64_t total = 0;
+    for (const TileMap::value_type &entry: m_tiles) {
+        for (int r = 0; r < TILE_SIZE; ++r) {
+            total += PopCount64(entry.second->rows[r]);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "BitGrid.h"
+#include "CompiledRule.h"
+
+/**
+ * @brief 稀疏分块宇宙 (Sparse Tile Universe)
+ *
+ * 无边界平面，只存储含有活细胞的 64x64 分块，以分块坐标为键放在哈希表中。
+ * 每个分块的一行正好是一个 64 位字，直接套用位并行内核 (西/东邻居从左右分块的同一行借一位)。
+ *
+ * 每代只计算已有分块以及活细胞贴边一侧的相邻分块：活动扩散到哪里，分块就分配到哪里；
+ * 演化后变空的分块立即释放。因此内存与活区域面积成正比，而不是与包围盒面积成正比，
+ * 远处的滑翔机不会让中间的空白占用内存。
+ *
+ * 坐标为 64 位有符号整数。只支持不含 B0 的两态 3x3 全和规则 (B0 会让无限的空白区域在下一代全部出生)。
+ */
+class SparseUniverse {
+public:
+    static constexpr int TILE_SIZE = 64; ///< 分块边长 (细胞)
+
+    SparseUniverse();
+
+    ~SparseUniverse();
+
+    SparseUniverse(const SparseUniverse &) = delete;
+    SparseUniverse &operator=(const SparseUniverse &) = delete;
+
+    /**
+     * @brief 清空宇宙并释放所有分块
+     */
+    void Clear();
+
+    /**
+     * @brief 设置演化规则
+     * @return bool 规则含 B0、为 Generations、LtL 或非全和规则时返回 false，规则不变
+     */
+    bool SetRule(const CompiledRule &rule);
+
+    /**
+     * @brief 判断规则是否可以在无边界平面上演化 (不含 B0 的两态 3x3 全和规则)
+     */
+    static bool IsRuleSupported(const CompiledRule &rule);
+
+    /**
+     * @brief 推进一代
+     */
+    void Step();
+
+    uint64_t GetGeneration() const { return m_generation; }
+
+    void SetCell(int64_t x, int64_t y, bool state);
+
+    bool GetCell(int64_t x, int64_t y) const;
+
+    /**
+     * @brief 用位平面网格替换宇宙中的矩形区域 (x, y, grid 宽, grid 高)
+     *
+     * 按字合并，区域外的内容保持不变。
+     */
+    void ImportRegion(int64_t x, int64_t y, const BitGrid &grid);
+
+    /**
+     * @brief 把宇宙中的矩形区域 (x, y, grid 宽, grid 高) 写入位平面网格
+     *
+     * 整个网格先被清空，只遍历已分配的分块。
+     */
+    void ExportRegion(int64_t x, int64_t y, BitGrid &grid) const;
+
+    /**
+     * @brief 获取活细胞总数
+     */
+    uint64_t GetPopulation() const;
+
+    /**
+     * @brief 获取已分配的分块数
+     */
+    size_t GetTileCount() const { return m_tiles.size(); }
+
+    /**
+     * @brief 分块数据占用的字节数 (不含哈希表自身的开销)
+     */
+    size_t GetMemoryBytes() const { return (m_tiles.size() + m_spareTiles.size()) * sizeof(TileData); }
+
+private:
+    /**
+     * @brief 分块坐标 (细胞坐标除以 64 向下取整)
+     */
+    struct TileKey {
+        int64_t x;
+        int64_t y;
+
+        bool operator==(const TileKey &other) const { return x == other.x && y == other.y; }
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey &key) const {
+            const uint64_t h = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ULL ^
+                               static_cast<uint64_t>(key.y) * 0xC2B2AE3D27D4EB4FULL;
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    /**
+     * @brief 分块数据：第 r 行的第 j 位是细胞 (64*key.x + j, 64*key.y + r)
+     */
+    struct TileData {
+        uint64_t rows[TILE_SIZE];
+    };
+
+    typedef std::unordered_map<TileKey, std::unique_ptr<TileData>, TileKeyHash> TileMap;
+
+    static int64_t TileIndex(int64_t v) { return v >> 6; } ///< 算术右移，即向下取整除以 64
+
+    const TileData *FindTile(int64_t tx, int64_t ty) const;
+
+    /**
+     * @brief 取一个清零的分块 (优先复用回收的分块)
+     */
+    std::unique_ptr<TileData> AllocTile();
+
+    /**
+     * @brief 回收分块，备用分块数不超过活分块数
+     */
+    void FreeTile(std::unique_ptr<TileData> tile);
+
+    /**
+     * @brief 收集本代需要计算的分块：所有已有分块，以及活细胞贴边方向上的相邻分块
+     */
+    void CollectCandidates();
+
+    /**
+     * @brief 计算一个分块的下一代
+     * @return bool 结果中是否有活细胞
+     */
+    bool StepTile(const TileKey &key, TileData &out) const;
+
+    TileMap m_tiles; ///< 当前代的分块
+    TileMap m_nextTiles; ///< 下一代的分块 (演化时使用)
+    std::unordered_set<TileKey, TileKeyHash> m_candidates; ///< 本代需要计算的分块
+    std::vector<std::unique_ptr<TileData> > m_spareTiles; ///< 回收的分块
+    TileData m_emptyTile; ///< 全零分块，代替不存在的邻居
+    uint64_t m_generation; ///< 已推进的代数
+    CompiledRule m_rule; ///< 当前规则
+};
@@ -1,6 +1,7 @@
 #include "SplashWindow.h"
 #include <tchar.h>
 #include <cmath>
+#include <ctime>
 #include <algorithm>
 
 // 链接 msimg32.lib 以使用 GradientFill (如果需要)
@@ -139,6 +140,8 @@ LRESULT SplashWindow::WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam
  * 生成大量随机分布的星星，用于 3D 飞行效果。
  */
 void SplashWindow::InitStars(int width, int height) {
+    // 星空只是装饰，每次启动取不同的分布即可
+    srand(static_cast<unsigned int>(time(nullptr)));
     m_stars.clear();
     int count = 2500; // 星星数量
     for (int i = 0; i < count; ++i) {
@@ -0,0 +1,39 @@
+#include "StateGrid.h"
+#include <algorithm>
+
+StateGrid::StateGrid()
+    : m_width(0), m_height(0) {
+}
+
+void StateGrid::Resize(int width, int height) {
+    if (width < 0) width = 0;
+    if (height < 0) height = 0;
+    m_width = width;
+    m_height = height;
+    m_cells.assign(static_cast<size_t>(width) * height, 0);
+}
+
+void StateGrid::Clear() {
+    std::fill(m_cells.begin(), m_cells.end(), 0);
+}
+
+void StateGrid::Swap(StateGrid &other) noexcept {
+    m_cells.swap(other.m_cells);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+}
+
+void StateGrid::SyncFromBits(const BitGrid &alive, int x, int y, int w, int h) {
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(std::min(x + w, m_width), alive.GetWidth());
+    const int y1 = std::min(std::min(y + h, m_height), alive.GetHeight());
+
+    for (int yy = y0; yy < y1; ++yy) {
+        const uint64_t *bits = alive.GetRow(yy);
+        uint8_t *row = GetRow(yy);
+        for (int xx = x0; xx < x1; ++xx) {
+            row[xx] = static_cast<uint8_t>((bits[xx >> 6] >> (xx & 63)) & 1ULL);
+        }
+    }
+}
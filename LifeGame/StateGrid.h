@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BitGrid.h"
+
+/**
+ * @brief 字节状态平面 (Byte State Plane)
+ *
+ * 每个细胞占 1 字节，按行优先连续存储，行步长等于宽度。
+ * 供 Generations 规则记录衰减态：0 为死，1 为活，2 .. states-1 为衰减中。
+ *
+ * 活细胞仍然同时记录在位平面网格中 (位为 1 当且仅当状态为 1)，
+ * 邻居计数、统计与渲染照常读取位平面，只有衰减处理需要读写这里。
+ */
+class StateGrid {
+public:
+    StateGrid();
+
+    /**
+     * @brief 调整大小，所有细胞被清零
+     */
+    void Resize(int width, int height);
+
+    void Clear();
+
+    /**
+     * @brief 与另一个平面交换缓冲区 (O(1)，用于双缓冲翻转)
+     */
+    void Swap(StateGrid &other) noexcept;
+
+    uint8_t Get(int x, int y) const { return m_cells[static_cast<size_t>(y) * m_width + x]; }
+
+    void Set(int x, int y, uint8_t state) { m_cells[static_cast<size_t>(y) * m_width + x] = state; }
+
+    uint8_t *GetRow(int y) { return m_cells.data() + static_cast<size_t>(y) * m_width; }
+    const uint8_t *GetRow(int y) const { return m_cells.data() + static_cast<size_t>(y) * m_width; }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    /**
+     * @brief 用位平面重写矩形区域 (活细胞为 1，其余为 0，区域内的衰减态被清除)
+     *
+     * 区域会被裁剪到平面范围内。用于直接编辑位平面之后保持两者一致。
+     */
+    void SyncFromBits(const BitGrid &alive, int x, int y, int w, int h);
+
+private:
+    std::vector<uint8_t> m_cells;
+    int m_width;
+    int m_height;
+};
@@ -1,12 +1,14 @@
 #include "Statistics.h"
+#include "BitOps.h"
 #include <algorithm>
 
 /**
  * @brief 构造函数
  */
 Statistics::Statistics(int width, int height)
-    : m_maxPopulation(0), m_totalPopulation(0), m_frameCount(0), m_maxHeat(0),
-      m_width(width), m_height(height) {
+    : m_populationHistory(DEFAULT_HISTORY_SIZE), m_birthHistory(DEFAULT_HISTORY_SIZE),
+      m_deathHistory(DEFAULT_HISTORY_SIZE), m_maxHeat(0), m_heatPending(false),
+      m_wordsPerRow(0), m_width(0), m_height(0), m_activeTiles(0), m_totalTiles(0), m_boardHash(0) {
     Reset(width, height);
 }
 
@@ -20,70 +22,146 @@ Statistics::~Statistics() {
  * @brief 重置统计数据
  */
 void Statistics::Reset(int width, int height) {
+    // 初始化热力图：尺寸不变且缓冲区已按该尺寸分配时原地清零；
+    // 否则先分配新尺寸，成功后再交换，分配失败时所有数据原样保留
+    const int wordsPerRow = BitGrid::WordsForWidth(width);
+    const size_t heatCells = static_cast<size_t>(width) * height;
+    const size_t planeWords = static_cast<size_t>(wordsPerRow) * height * HEAT_PLANES;
+    if (m_heatMap.size() == heatCells && m_heatPlanes.size() == planeWords) {
+        std::fill(m_heatMap.begin(), m_heatMap.end(), 0u);
+        std::fill(m_heatPlanes.begin(), m_heatPlanes.end(), 0ULL);
+    } else {
+        std::vector<unsigned int> heatMap(heatCells, 0);
+        std::vector<uint64_t> heatPlanes(planeWords, 0);
+        m_heatMap.swap(heatMap);
+        m_heatPlanes.swap(heatPlanes);
+    }
+    m_maxHeat = 0;
+    m_heatPending = false;
     m_width = width;
     m_height = height;
+    m_wordsPerRow = wordsPerRow;
 
-    m_populationHistory.clear();
-    m_maxPopulation = 0;
-    m_totalPopulation = 0;
-    m_frameCount = 0;
+    m_populationHistory.Clear();
+    m_birthHistory.Clear();
+    m_deathHistory.Clear();
+    m_populationPyramid.Clear();
 
-    // 初始化热力图
-    m_heatMap.assign(height, std::vector<unsigned int>(width, 0));
-    m_maxHeat = 0;
+    m_activeTiles = 0;
+    m_totalTiles = 0;
+
+    m_boardHash = 0;
+    m_cycleDetector.Clear();
+}
+
+void Statistics::SetHistorySize(size_t frames) {
+    m_populationHistory.SetCapacity(frames);
+    m_birthHistory.SetCapacity(frames);
+    m_deathHistory.SetCapacity(frames);
 }
 
 /**
- * @brief 记录一帧数据
+ * @brief 重新开始周期检测
  */
-void Statistics::RecordFrame(int population, const std::vector<std::vector<bool> > &grid) {
-    // 1. 更新种群历史
-    m_populationHistory.push_back(population);
-    if (m_populationHistory.size() > MAX_HISTORY_SIZE) {
-        m_populationHistory.pop_front();
-    }
+void Statistics::ResetCycleDetection(uint64_t hash, long long generation) {
+    m_boardHash = hash;
+    m_cycleDetector.Reset(hash, generation);
+}
 
-    // 更新最大值
-    if (population > m_maxPopulation) {
-        m_maxPopulation = population;
-    } else if (m_populationHistory.size() == MAX_HISTORY_SIZE) {
-        // 如果队列满了，且刚才弹出的可能是最大值，我们需要重新扫描最大值
-        // 这是一个 O(N) 操作，但 N 很小 (200)，所以没问题
-        m_maxPopulation = 0;
-        for (int p: m_populationHistory) {
-            if (p > m_maxPopulation) m_maxPopulation = p;
-        }
-    }
+void Statistics::StopCycleDetection() {
+    m_cycleDetector.Clear();
+}
+
+/**
+ * @brief 记录棋盘哈希
+ */
+bool Statistics::RecordBoardHash(uint64_t hash, long long generation) {
+    m_boardHash = hash;
+    return m_cycleDetector.Observe(hash, generation);
+}
+
+/**
+ * @brief 记录活跃分块数
+ */
+void Statistics::RecordActiveTiles(int activeTiles, int totalTiles) {
+    m_activeTiles = activeTiles;
+    m_totalTiles = totalTiles;
+}
 
-    m_totalPopulation += population;
-    m_frameCount++;
+/**
+ * @brief 记录一帧数据
+ */
+void Statistics::RecordFrame(long long population, long long births, long long deaths, const BitGrid &grid) {
+    // 1. 更新种群与出生/死亡历史 (窗口满时最老的一帧离开，最值与平均值随之 O(1) 更新)
+    m_populationHistory.Push(population);
+    m_birthHistory.Push(births);
+    m_deathHistory.Push(deaths);
+    m_populationPyramid.Push(population);
 
     // 2. 更新热力图
     // 确保网格大小匹配
-    if (grid.size() != static_cast<size_t>(m_height) || (m_height > 0 && grid[0].size() != static_cast<size_t>(
-                                                             m_width))) {
+    if (grid.GetHeight() != m_height || grid.GetWidth() != m_width) {
         // 如果网格大小变了，重置热力图
-        Reset(static_cast<int>(grid[0].size()), static_cast<int>(grid.size()));
+        Reset(grid.GetWidth(), grid.GetHeight());
     }
 
+    // 位切片计数器：活细胞字作为进位输入，逐个平面做行波进位加法，进位为 0 即停止
+    // 行尾填充位恒为 0 (见 BitGrid)，不会被计数
     for (int y = 0; y < m_height; ++y) {
-        for (int x = 0; x < m_width; ++x) {
-            if (grid[y][x]) {
-                m_heatMap[y][x]++;
-                if (m_heatMap[y][x] > m_maxHeat) {
-                    m_maxHeat = m_heatMap[y][x];
-                }
+        const uint64_t *row = grid.GetRow(y);
+        uint64_t *planes = &m_heatPlanes[static_cast<size_t>(y) * m_wordsPerRow * HEAT_PLANES];
+        for (int i = 0; i < m_wordsPerRow; ++i, planes += HEAT_PLANES) {
+            uint64_t carry = row[i];
+            for (int k = 0; carry != 0 && k < HEAT_PLANES; ++k) {
+                const uint64_t next = planes[k] & carry;
+                planes[k] ^= carry;
+                carry = next;
+            }
+            // 最高平面溢出的细胞低位已回绕为 0，把 2^HEAT_PLANES 直接加到稠密数组 (每个细胞至多每 256 帧一次)
+            unsigned int *heatRow = &m_heatMap[static_cast<size_t>(y) * m_width];
+            while (carry) {
+                const int x = i * BitGrid::WORD_BITS + CountTrailingZeros64(carry);
+                carry &= carry - 1;
+                heatRow[x] += 1u << HEAT_PLANES;
+                if (heatRow[x] > m_maxHeat) m_maxHeat = heatRow[x];
             }
         }
     }
+    m_heatPending = true;
 }
 
 /**
- * @brief 获取平均种群
+ * @brief 合并位平面中的计数
+ *
+ * 各平面全为 0 的字 (从未存活或刚合并过的区域) 整字跳过，其余按位取出计数加到稠密数组。
  */
-double Statistics::GetAveragePopulation() const {
-    if (m_frameCount == 0) return 0.0;
-    return static_cast<double>(m_totalPopulation) / m_frameCount;
+void Statistics::FlushHeat() const {
+    if (!m_heatPending) return;
+    for (int y = 0; y < m_height; ++y) {
+        uint64_t *planes = &m_heatPlanes[static_cast<size_t>(y) * m_wordsPerRow * HEAT_PLANES];
+        unsigned int *heatRow = &m_heatMap[static_cast<size_t>(y) * m_width];
+        for (int i = 0; i < m_wordsPerRow; ++i, planes += HEAT_PLANES) {
+            uint64_t any = 0;
+            for (int k = 0; k < HEAT_PLANES; ++k) {
+                any |= planes[k];
+            }
+            while (any) {
+                const int bit = CountTrailingZeros64(any);
+                any &= any - 1;
+                unsigned int count = 0;
+                for (int k = 0; k < HEAT_PLANES; ++k) {
+                    count |= static_cast<unsigned int>((planes[k] >> bit) & 1ULL) << k;
+                }
+                unsigned int &heat = heatRow[i * BitGrid::WORD_BITS + bit];
+                heat += count;
+                if (heat > m_maxHeat) m_maxHeat = heat;
+            }
+            for (int k = 0; k < HEAT_PLANES; ++k) {
+                planes[k] = 0;
+            }
+        }
+    }
+    m_heatPending = false;
 }
 
 /**
@@ -91,7 +169,18 @@ double Statistics::GetAveragePopulation() const {
  */
 unsigned int Statistics::GetHeatValue(int x, int y) const {
     if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-        return m_heatMap[y][x];
+        FlushHeat();
+        return m_heatMap[static_cast<size_t>(y) * m_width + x];
     }
     return 0;
 }
+
+unsigned int Statistics::GetMaxHeat() const {
+    FlushHeat();
+    return m_maxHeat;
+}
+
+const std::vector<unsigned int> &Statistics::GetHeatMap() const {
+    FlushHeat();
+    return m_heatMap;
+}
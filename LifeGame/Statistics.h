@@ -1,6 +1,10 @@
 #pragma once
 #include <vector>
 #include <deque>
+#include "BitGrid.h"
+#include "CycleDetector.h"
+#include "HistoryPyramid.h"
+#include "SlidingWindow.h"
 
 /**
  * @brief 统计数据管理器
@@ -8,9 +12,17 @@
  * 负责收集、分析和存储游戏的运行时统计数据。
  * 包括种群数量历史、帧率历史、以及细胞活跃度热力图。
  * 这些数据用于在界面上绘制图表，增强科技感。
+ *
+ * 热力图的低位以位切片 (Bit-Sliced) 的纵向计数器累加：HEAT_PLANES 个位平面，第 k 个平面保存
+ * 每个细胞计数的第 k 位，与网格一样 64 个细胞一个字。每帧只需对每个字做一次行波进位加法
+ * (一般一两个平面之后进位就为 0)，不再逐细胞访问。计数只在读取热力值时才合并进稠密数组。
  */
 class Statistics {
 public:
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 200; ///< 默认保留最近 200 帧的数据
+    static constexpr int HEAT_PLANES = 8; ///< 位切片计数器的平面数 (低位计数上限 2^8 - 1)
+    static constexpr size_t BYTES_PER_CELL = sizeof(unsigned int) + HEAT_PLANES / 8; ///< 热力图每个细胞占用的字节数 (稠密数组 + 位平面，计入内存预算)
+
     /**
      * @brief 构造函数
      * @param width 网格宽度
@@ -22,6 +34,9 @@ public:
 
     /**
      * @brief 重置统计数据
+     *
+     * 尺寸改变时热力图按新尺寸重新分配，内存不足时抛出 std::bad_alloc，此时统计数据原样保留 (强异常保证)；
+     * 分配成功之后的清空步骤不会抛出异常。
      * @param width 新网格宽度
      * @param height 新网格高度
      */
@@ -31,25 +46,75 @@ public:
      * @brief 记录一帧的数据
      * 
      * @param population 当前活细胞数量
-     * @param grid 当前网格数据 (用于更新热力图)
+     * @param births 上一帧以来出生的细胞数 (由演化内核逐代累计)
+     * @param deaths 上一帧以来死亡的细胞数
+     * @param grid 当前位平面网格 (用于更新热力图)
+     */
+    void RecordFrame(long long population, long long births, long long deaths, const BitGrid &grid);
+
+    /**
+     * @brief 记录本代实际计算的分块数
+     *
+     * @param activeTiles 本代重新计算的分块数
+     * @param totalTiles 分块总数
+     */
+    void RecordActiveTiles(int activeTiles, int totalTiles);
+
+    /**
+     * @brief 设置历史窗口的长度 (帧)
+     *
+     * 最值与平均值由单调队列和累加和维护，代价与窗口长度无关，可以设到 10 万帧以上。
+     * 缩短窗口时丢弃最老的数据，Reset 不改变窗口长度。
      */
-    void RecordFrame(int population, const std::vector<std::vector<bool> > &grid);
+    void SetHistorySize(size_t frames);
+
+    size_t GetHistorySize() const { return m_populationHistory.GetCapacity(); }
 
     /**
      * @brief 获取种群历史数据
-     * @return const std::deque<int>& 种群数量队列
+     * @return const std::deque<long long>& 种群数量队列
+     */
+    const std::deque<long long> &GetPopulationHistory() const { return m_populationHistory.GetValues(); }
+
+    /**
+     * @brief 获取自 Reset 以来全部帧的种群金字塔 (按任意范围、任意列数汇总，用于长时间运行的图表)
+     */
+    const HistoryPyramid &GetPopulationPyramid() const { return m_populationPyramid; }
+
+    /**
+     * @brief 获取每帧出生数的历史 (与种群历史一一对应)
      */
-    const std::deque<int> &GetPopulationHistory() const { return m_populationHistory; }
+    const std::deque<long long> &GetBirthHistory() const { return m_birthHistory.GetValues(); }
 
     /**
-     * @brief 获取最大种群数量 (用于图表归一化)
+     * @brief 获取每帧死亡数的历史 (与种群历史一一对应)
      */
-    int GetMaxPopulation() const { return m_maxPopulation; }
+    const std::deque<long long> &GetDeathHistory() const { return m_deathHistory.GetValues(); }
 
     /**
-     * @brief 获取平均种群数量
+     * @brief 获取窗口内的最大种群数量 (用于图表归一化)
      */
-    double GetAveragePopulation() const;
+    long long GetMaxPopulation() const { return m_populationHistory.GetMax(); }
+
+    /**
+     * @brief 获取窗口内的最小种群数量
+     */
+    long long GetMinPopulation() const { return m_populationHistory.GetMin(); }
+
+    /**
+     * @brief 获取窗口内的平均种群数量
+     */
+    double GetAveragePopulation() const { return m_populationHistory.GetMean(); }
+
+    /**
+     * @brief 获取窗口内每帧的平均出生数
+     */
+    double GetAverageBirths() const { return m_birthHistory.GetMean(); }
+
+    /**
+     * @brief 获取窗口内每帧的平均死亡数
+     */
+    double GetAverageDeaths() const { return m_deathHistory.GetMean(); }
 
     /**
      * @brief 获取指定位置的热力值
@@ -65,20 +130,82 @@ public:
     /**
      * @brief 获取最大热力值 (用于颜色映射)
      */
-    unsigned int GetMaxHeat() const { return m_maxHeat; }
+    unsigned int GetMaxHeat() const;
+
+    /**
+     * @brief 获取整张热力图 (按行连续存储，下标 y * width + x；用于导出)
+     */
+    const std::vector<unsigned int> &GetHeatMap() const;
+
+    /**
+     * @brief 获取最近一代实际计算的分块数 (其余分块因稳定而被跳过)
+     */
+    int GetActiveTileCount() const { return m_activeTiles; }
+
+    /**
+     * @brief 获取分块总数
+     */
+    int GetTileCount() const { return m_totalTiles; }
+
+    // ==========================================
+    // 周期检测 (Cycle Detection)
+    // ==========================================
+
+    /**
+     * @brief 从当前棋盘重新开始周期检测
+     * @param hash 当前棋盘哈希
+     * @param generation 当前代数
+     */
+    void ResetCycleDetection(uint64_t hash, long long generation);
+
+    /**
+     * @brief 停止周期检测并清除结果
+     */
+    void StopCycleDetection();
+
+    /**
+     * @brief 记录新一代的棋盘哈希
+     * @return bool 本代首次检测到周期时返回 true
+     */
+    bool RecordBoardHash(uint64_t hash, long long generation);
+
+    /**
+     * @brief 获取最近一次记录的棋盘哈希
+     */
+    uint64_t GetBoardHash() const { return m_boardHash; }
+
+    /**
+     * @brief 获取周期检测结果 (周期与进入周期的代数)
+     */
+    const CycleInfo &GetCycleInfo() const { return m_cycleDetector.GetInfo(); }
 
 private:
-    // 历史数据配置
-    static constexpr int MAX_HISTORY_SIZE = 200; ///< 保留最近 200 帧的数据
+    SlidingWindow m_populationHistory; ///< 种群历史窗口 (大网格的种群数可能超过 int 范围)
+    SlidingWindow m_birthHistory; ///< 每帧出生数历史窗口
+    SlidingWindow m_deathHistory; ///< 每帧死亡数历史窗口
+    HistoryPyramid m_populationPyramid; ///< 全部帧的多分辨率种群历史 (内存固定)
 
-    std::deque<int> m_populationHistory; ///< 种群历史队列
-    int m_maxPopulation; ///< 历史最大种群数
-    long long m_totalPopulation; ///< 历史总种群数 (用于计算平均值)
-    long long m_frameCount; ///< 总帧数
+    /**
+     * @brief 把位平面中的计数合并进稠密数组并清零位平面
+     *
+     * 只改变热力图的存储方式，不改变热力值，因此可以在 const 的读取接口中调用 (相关成员为 mutable)。
+     */
+    void FlushHeat() const;
 
     // 热力图数据
-    std::vector<std::vector<unsigned int> > m_heatMap; ///< 热力图网格
-    unsigned int m_maxHeat; ///< 全局最大热力值
+    mutable std::vector<uint64_t> m_heatPlanes; ///< 位切片计数器 (每个字 HEAT_PLANES 个平面相邻存放，下标 (y * wordsPerRow + w) * HEAT_PLANES + k)
+    mutable std::vector<unsigned int> m_heatMap; ///< 稠密热力图 (按行连续存储，下标 y * width + x)，只含已合并的计数
+    mutable unsigned int m_maxHeat; ///< 稠密热力图中的最大值
+    mutable bool m_heatPending; ///< 位平面中是否还有未合并的计数
+    int m_wordsPerRow; ///< 网格每行的字数
     int m_width;
     int m_height;
+
+    // 分块活跃度
+    int m_activeTiles; ///< 最近一代实际计算的分块数
+    int m_totalTiles; ///< 分块总数
+
+    // 周期检测
+    uint64_t m_boardHash; ///< 最近一次记录的棋盘哈希
+    CycleDetector m_cycleDetector; ///< Brent 周期检测器
 };
@@ -0,0 +1,193 @@
+#include "StatisticsSink.h"
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+
+constexpr int StatisticsSink::IDLE_SLEEP_MS;
+
+/**
+ * @brief 打开文件 (MSVC 的 SDL 检查不允许直接调用 fopen)
+ */
+static FILE *OpenFile(const std::string &path, const char *mode) {
+#ifdef _MSC_VER
+    FILE *fp = nullptr;
+    if (fopen_s(&fp, path.c_str(), mode) != 0) return nullptr;
+    return fp;
+#else
+    return fopen(path.c_str(), mode);
+#endif
+}
+
+/**
+ * @brief errno 的文字说明
+ */
+static std::string ErrorText(int error) {
+#ifdef _MSC_VER
+    char buffer[128];
+    strerror_s(buffer, sizeof(buffer), error);
+    return buffer;
+#else
+    return strerror(error);
+#endif
+}
+
+StatisticsSink::StatisticsSink()
+    : m_mask(0), m_head(0), m_tail(0), m_dropped(0), m_written(0), m_stop(false), m_file(nullptr),
+      m_format(SinkFormat::Csv), m_failed(false) {
+}
+
+StatisticsSink::~StatisticsSink() {
+    Close();
+}
+
+bool StatisticsSink::Open(const std::string &path, SinkFormat format, size_t capacity) {
+    Close();
+    m_lastError.clear();
+    m_file = OpenFile(path, format == SinkFormat::Csv ? "w" : "wb");
+    if (m_file == nullptr) {
+        m_lastError = "Cannot open " + path + ": " + ErrorText(errno);
+        return false;
+    }
+
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    m_ring.assign(size, GenerationRecord());
+    m_mask = size - 1;
+    m_head.store(0, std::memory_order_relaxed);
+    m_tail.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+    m_written.store(0, std::memory_order_relaxed);
+    m_stop.store(false, std::memory_order_relaxed);
+    m_format = format;
+    m_failed = false;
+
+    // 文件头
+    bool ok;
+    if (format == SinkFormat::Csv) {
+        ok = fputs("generation,population,births,deaths,min_x,min_y,max_x,max_y,hash\n", m_file) >= 0;
+    } else {
+        const char magic[8] = {'L', 'G', 'S', 'T', 'A', 'T', 'S', '\0'};
+        const uint32_t header[2] = {1, 9};
+        ok = fwrite(magic, sizeof(magic), 1, m_file) == 1 && fwrite(header, sizeof(header), 1, m_file) == 1;
+    }
+    if (!ok) {
+        m_lastError = "Cannot write header to " + path;
+        fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_writer = std::thread(&StatisticsSink::WriterLoop, this);
+    return true;
+}
+
+bool StatisticsSink::Close() {
+    if (m_file == nullptr) return true;
+    m_stop.store(true, std::memory_order_release);
+    if (m_writer.joinable()) m_writer.join();
+
+    if (fclose(m_file) != 0 && !m_failed) {
+        m_failed = true;
+        m_lastError = "Cannot close statistics file";
+    }
+    m_file = nullptr;
+    std::vector<GenerationRecord>().swap(m_ring);
+    return !m_failed;
+}
+
+/**
+ * @brief 生产者：写入一格并发布新的 head
+ *
+ * tail 的 acquire 读保证写线程已经取走的格子才会被覆盖，head 的 release 写保证写线程看到完整的记录。
+ */
+bool StatisticsSink::Push(const GenerationRecord &record) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) > m_mask) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_ring[head & m_mask] = record;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 写线程主循环
+ *
+ * 先把一批记录拷出环形缓冲并立即归还格子，再做格式化与 I/O，缓冲占用的时间尽量短。
+ * 写入出错后继续取出 (并丢弃) 记录，生产者不会因此被堵住。
+ */
+void StatisticsSink::WriterLoop() {
+    std::vector<GenerationRecord> batch;
+    batch.reserve(MAX_BATCH);
+    for (;;) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        if (head == tail) {
+            // 先读 stop 再确认缓冲为空：stop 之前提交的记录一定已经可见
+            if (m_stop.load(std::memory_order_acquire) && m_head.load(std::memory_order_acquire) == tail) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_MS));
+            continue;
+        }
+
+        const size_t count = head - tail < MAX_BATCH ? head - tail : MAX_BATCH;
+        batch.clear();
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(m_ring[(tail + i) & m_mask]);
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+
+        if (!m_failed) {
+            if (WriteBatch(batch)) {
+                m_written.fetch_add(count, std::memory_order_relaxed);
+            } else {
+                m_failed = true;
+                m_lastError = "Write failed: " + ErrorText(errno);
+            }
+        }
+    }
+    if (!m_failed && fflush(m_file) != 0) {
+        m_failed = true;
+        m_lastError = "Flush failed: " + ErrorText(errno);
+    }
+}
+
+bool StatisticsSink::WriteBatch(const std::vector<GenerationRecord> &batch) {
+    if (m_format == SinkFormat::Csv) {
+        for (const GenerationRecord &r: batch) {
+            if (fprintf(m_file, "%lld,%lld,%lld,%lld,%d,%d,%d,%d,%016" PRIx64 "\n", r.generation, r.population,
+                        r.births, r.deaths, r.minX, r.minY, r.maxX, r.maxY, r.hash) < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 按列写出：同一字段的值相邻存放，便于分析工具直接映射为数组
+    const size_t n = batch.size();
+    const uint32_t header[2] = {static_cast<uint32_t>(n), 0};
+    std::vector<int64_t> wide(n);
+    std::vector<int32_t> narrow(n);
+    std::vector<uint64_t> hashes(n);
+    bool ok = fwrite(header, sizeof(header), 1, m_file) == 1;
+    auto writeWide = [&](long long GenerationRecord::*field) {
+        for (size_t i = 0; i < n; ++i) wide[i] = batch[i].*field;
+        ok = ok && fwrite(wide.data(), sizeof(int64_t), n, m_file) == n;
+    };
+    auto writeNarrow = [&](int GenerationRecord::*field) {
+        for (size_t i = 0; i < n; ++i) narrow[i] = batch[i].*field;
+        ok = ok && fwrite(narrow.data(), sizeof(int32_t), n, m_file) == n;
+    };
+    writeWide(&GenerationRecord::generation);
+    writeWide(&GenerationRecord::population);
+    writeWide(&GenerationRecord::births);
+    writeWide(&GenerationRecord::deaths);
+    writeNarrow(&GenerationRecord::minX);
+    writeNarrow(&GenerationRecord::minY);
+    writeNarrow(&GenerationRecord::maxX);
+    writeNarrow(&GenerationRecord::maxY);
+    for (size_t i = 0; i < n; ++i) hashes[i] = batch[i].hash;
+    ok = ok && fwrite(hashes.data(), sizeof(uint64_t), n, m_file) == n;
+    return ok;
+}
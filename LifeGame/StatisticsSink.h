@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 一代的统计记录
+ */
+struct GenerationRecord {
+    long long generation; ///< 代数
+    long long population; ///< 活细胞数
+    long long births; ///< 本代出生数
+    long long deaths; ///< 本代死亡数
+    int minX; ///< 活细胞外接矩形 (网格坐标，含两端)，棋盘为空时四个坐标均为 -1
+    int minY;
+    int maxX;
+    int maxY;
+    uint64_t hash; ///< 棋盘哈希 (见 BoardHash)
+};
+
+/**
+ * @brief 统计记录的输出格式
+ */
+enum class SinkFormat {
+    Csv, ///< 文本，每代一行
+    Binary ///< 紧凑的按列二进制
+};
+
+/**
+ * @brief 逐代统计的流式输出
+ *
+ * 演化线程 (唯一的生产者) 把记录写入固定容量的环形缓冲，只有两次原子读写，不加锁、不做 I/O；
+ * 后台写线程 (唯一的消费者) 成批取出记录，格式化后一次写入文件。
+ * 写线程跟不上时缓冲会满，此时新记录被丢弃并计数 (GetDroppedCount)，演化永远不会因为磁盘而停顿。
+ *
+ * 二进制格式 (主机字节序)：
+ *   - 文件头 16 字节："LGSTATS\0"、uint32 版本号 (1)、uint32 每条记录的字段数 (9)；
+ *   - 之后是若干数据块，每块为 uint32 记录数 n、uint32 保留 (0)，随后按列存放：
+ *     generation、population、births、deaths 各 n 个 int64，minX、minY、maxX、maxY 各 n 个 int32，hash n 个 uint64。
+ */
+class StatisticsSink {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16; ///< 默认缓冲容量 (记录数)
+    static constexpr size_t MAX_BATCH = 4096; ///< 写线程每批最多取出的记录数 (也是二进制数据块的最大长度)
+    static constexpr int IDLE_SLEEP_MS = 1; ///< 缓冲为空时写线程的休眠时间
+
+    StatisticsSink();
+
+    ~StatisticsSink();
+
+    StatisticsSink(const StatisticsSink &) = delete;
+    StatisticsSink &operator=(const StatisticsSink &) = delete;
+
+    /**
+     * @brief 打开输出文件并启动写线程
+     * @param capacity 缓冲容量 (记录数)，向上取整到 2 的幂
+     * @return bool 文件无法创建时返回 false (见 GetLastError)
+     */
+    bool Open(const std::string &path, SinkFormat format, size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief 写完缓冲中剩余的记录，停止写线程并关闭文件
+     * @return bool 期间发生过写入错误时返回 false (见 GetLastError)
+     */
+    bool Close();
+
+    bool IsOpen() const { return m_file != nullptr; }
+
+    /**
+     * @brief 提交一条记录 (只能由一个线程调用)
+     * @return bool 缓冲已满、记录被丢弃时返回 false
+     */
+    bool Push(const GenerationRecord &record);
+
+    /**
+     * @brief 因缓冲已满而丢弃的记录数
+     */
+    unsigned long long GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 已经写入文件的记录数
+     */
+    unsigned long long GetWrittenCount() const { return m_written.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 最近一次错误的原因 (写线程中的错误在 Close 之后可读)
+     */
+    const std::string &GetLastError() const { return m_lastError; }
+
+private:
+    /**
+     * @brief 写线程主循环：成批取出记录并写入文件，停止后把剩余记录写完
+     */
+    void WriterLoop();
+
+    /**
+     * @brief 写出一批记录
+     */
+    bool WriteBatch(const std::vector<GenerationRecord> &batch);
+
+    std::vector<GenerationRecord> m_ring; ///< 环形缓冲 (下标为序号 & m_mask)
+    size_t m_mask; ///< 容量 - 1
+    std::atomic<size_t> m_head; ///< 生产者的下一个写入序号 (只由生产者写)
+    char m_headPad[64]; ///< 让 m_head 与 m_tail 不在同一缓存行，避免伪共享
+    std::atomic<size_t> m_tail; ///< 消费者的下一个读取序号 (只由写线程写)
+    char m_tailPad[64];
+    std::atomic<unsigned long long> m_dropped; ///< 丢弃的记录数
+    std::atomic<unsigned long long> m_written; ///< 写入的记录数
+    std::atomic<bool> m_stop; ///< 通知写线程收尾
+    std::thread m_writer; ///< 后台写线程
+    FILE *m_file; ///< 输出文件
+    SinkFormat m_format; ///< 输出格式
+    bool m_failed; ///< 写线程是否遇到过写入错误 (只由写线程写，Close 之后读)
+    std::string m_lastError; ///< 最近一次错误的原因
+};
@@ -0,0 +1,161 @@
+#include "TemporalBlocker.h"
+#include <algorithm>
+#include <cstring>
+
+constexpr int TemporalBlocker::MAX_DEPTH;
+
+TemporalBlocker::TemporalBlocker() : m_depth(DEFAULT_DEPTH) {
+}
+
+bool TemporalBlocker::IsSupported(BoundaryTopology topology, const CompiledRule &rule) {
+    return topology != BoundaryTopology::CrossSurface && !rule.IsGenerations() && !rule.IsLargerThanLife();
+}
+
+void TemporalBlocker::SetDepth(int depth) {
+    m_depth = std::max(1, std::min(depth, MAX_DEPTH));
+}
+
+/**
+ * @brief 读取一行中第 x 个细胞 (0 或 1)
+ */
+static uint8_t CellBit(const uint64_t *row, int x) {
+    return static_cast<uint8_t>((row[x >> 6] >> (x & 63)) & 1ULL);
+}
+
+/**
+ * @brief 把一行左右翻转后写入 out (out 须已清零)
+ */
+static void CopyRowMirrored(const uint64_t *row, uint64_t *out, int width) {
+    for (int x = 0; x < width; ++x) {
+        if (CellBit(row, x)) out[(width - 1 - x) >> 6] |= 1ULL << ((width - 1 - x) & 63);
+    }
+}
+
+/**
+ * @brief 条带高度
+ *
+ * 两块本地缓冲合计不超过 BAND_CACHE_BYTES；同时保证条带数至少是线程数的两倍，
+ * 但条带不低于 2 * depth 行，否则被重复计算的 Halo 会超过条带本身。
+ */
+int TemporalBlocker::ChooseBandRows(const BitGrid &grid, int depth, int threadCount) const {
+    const int height = grid.GetHeight();
+    const size_t rowBytes = static_cast<size_t>(grid.GetStride()) * sizeof(uint64_t);
+    int rows = static_cast<int>(BAND_CACHE_BYTES / (2 * rowBytes)) - 2 * depth;
+    rows = std::min(rows, (height + 2 * threadCount - 1) / (2 * threadCount));
+    rows = std::max(rows, std::max(2 * depth, 16));
+    return std::min(rows, height);
+}
+
+void TemporalBlocker::Run(const KernelTable &kernels, ThreadPool &pool, StepRowFn stepRow, BoundaryTopology topology, BitGrid &grid,
+                          BitGrid &scratch, int generations, const CompiledRule &rule, CellCounts *counts) {
+    const int height = grid.GetHeight();
+    if (counts) *counts = CellCounts();
+    while (generations > 0) {
+        const int depth = std::min(generations, m_depth);
+        const int bandRows = ChooseBandRows(grid, depth, pool.GetThreadCount());
+        const int bands = (height + bandRows - 1) / bandRows;
+        if (static_cast<int>(m_buffers.size()) < bands) m_buffers.resize(bands);
+
+        // 各条带只读 grid、只写 scratch 中自己的行，互不干扰
+        pool.Run(bands, [&](int band) {
+            const int firstRow = band * bandRows;
+            const int lastRow = std::min(height, firstRow + bandRows);
+            StepBand(kernels, m_buffers[band], stepRow, topology, grid, scratch, firstRow, lastRow, depth, rule,
+                     counts != nullptr);
+        });
+        if (counts) {
+            counts->population = 0;
+            for (int band = 0; band < bands; ++band) {
+                counts->population += m_buffers[band].counts.population;
+                counts->births += m_buffers[band].counts.births;
+                counts->deaths += m_buffers[band].counts.deaths;
+            }
+        }
+        grid.Swap(scratch);
+        generations -= depth;
+    }
+}
+
+/**
+ * @brief 推进一个条带
+ *
+ * 本地第 i 行对应网格第 firstRow - depth + i 行。每推进一代，有效范围两端各收缩一行，
+ * 条带本身的行 [depth, depth + lastRow - firstRow) 在每一代都有效，逐代计数只统计这些行。
+ */
+void TemporalBlocker::StepBand(const KernelTable &kernels, BandBuffer &buffer, StepRowFn stepRow, BoundaryTopology topology,
+                               const BitGrid &src, BitGrid &dst, int firstRow, int lastRow, int depth,
+                               const CompiledRule &rule, bool countCells) const {
+    const int width = src.GetWidth();
+    const int height = src.GetHeight();
+    const int wordsPerRow = src.GetWordsPerRow();
+    const int stride = src.GetStride();
+    const uint64_t lastWordMask = src.GetLastWordMask();
+    const int rows = lastRow - firstRow + 2 * depth;
+    const int ownRows = lastRow - firstRow;
+
+    if (buffer.front.GetWidth() != width || buffer.front.GetHeight() != rows) {
+        buffer.front.Resize(width, rows);
+        buffer.back.Resize(width, rows);
+    }
+    buffer.dead.assign(rows, 0);
+
+    // 1. 读入条带与上下 Halo (越界的行按拓扑取值)
+    for (int i = 0; i < rows; ++i) {
+        uint64_t *out = buffer.front.GetRow(i);
+        int y = firstRow - depth + i;
+        int turns = 0;
+        if (y < 0 || y >= height) {
+            if (topology == BoundaryTopology::DeadEdge) {
+                buffer.dead[i] = 1;
+                memset(out, 0, stride * sizeof(uint64_t));
+                memset(buffer.back.GetRow(i), 0, stride * sizeof(uint64_t));
+                continue;
+            }
+            y = WrapCoordinate(y, height, turns);
+        }
+        if (topology == BoundaryTopology::KleinBottle && (turns & 1)) {
+            memset(out, 0, stride * sizeof(uint64_t));
+            CopyRowMirrored(src.GetRow(y), out, width);
+        } else {
+            memcpy(out, src.GetRow(y), stride * sizeof(uint64_t));
+        }
+    }
+
+    // 2. 在本地缓冲内连续推进 depth 代
+    // 环面与克莱因瓶左右直接相接，幽灵列就是本行的另一端；有界平面为 0
+    const bool wrapColumns = topology != BoundaryTopology::DeadEdge;
+    buffer.counts = CellCounts();
+    for (int g = 1; g <= depth; ++g) {
+        for (int i = g; i < rows - g; ++i) {
+            if (buffer.dead[i]) continue;
+            const uint64_t *above = buffer.front.GetRow(i - 1);
+            const uint64_t *row = buffer.front.GetRow(i);
+            const uint64_t *below = buffer.front.GetRow(i + 1);
+            GhostCells ghosts = {0, 0};
+            if (wrapColumns) {
+                ghosts.west = static_cast<uint8_t>(CellBit(above, width - 1) | (CellBit(row, width - 1) << 1) |
+                                                   (CellBit(below, width - 1) << 2));
+                ghosts.east = static_cast<uint8_t>(CellBit(above, 0) | (CellBit(row, 0) << 1) |
+                                                   (CellBit(below, 0) << 2));
+            }
+            stepRow(above, row, below, buffer.back.GetRow(i), 0, wordsPerRow, wordsPerRow, width, lastWordMask,
+                    ghosts, rule);
+        }
+        // 条带本身的行刚算完、仍在缓存中，逐代比较前后两代；人口只取最后一代
+        if (countCells) {
+            CellCounts generation = CellCounts();
+            for (int i = depth; i < depth + ownRows; ++i) {
+                kernels.accumulateCounts(buffer.front.GetRow(i), buffer.back.GetRow(i), wordsPerRow, generation);
+            }
+            buffer.counts.population = generation.population;
+            buffer.counts.births += generation.births;
+            buffer.counts.deaths += generation.deaths;
+        }
+        buffer.front.Swap(buffer.back);
+    }
+
+    // 3. 只写回条带本身
+    for (int y = firstRow; y < lastRow; ++y) {
+        memcpy(dst.GetRow(y), buffer.front.GetRow(y - firstRow + depth), stride * sizeof(uint64_t));
+    }
+}
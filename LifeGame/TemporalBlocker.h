@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "BitGrid.h"
+#include "BitOps.h"
+#include "SimdKernel.h"
+#include "ThreadPool.h"
+#include "Topology.h"
+
+/**
+ * @brief 时间分块 (Temporal Blocking) 演化器
+ *
+ * 逐代演化时，每一代都要把整个网格从内存读一遍、写一遍；网格放不进 L2 时，耗时主要花在内存带宽上。
+ * 这里把网格切成横向条带，每个条带连同上下各 depth 行的 Halo 一次性读入两块本地缓冲，
+ * 在缓冲内连续推进 depth 代后只写回条带本身，访存量约降为原来的 1 / depth：
+ *
+ *   第 g 代只计算本地行 [g, rows - g)，越靠外的 Halo 行越早失效 (梯形)，
+ *   depth 代之后中间的条带行恰好仍然精确。相邻条带的 Halo 重叠，被重复计算的行约占 depth / 条带高度。
+ *
+ * 条带横跨整行，行首/行尾的幽灵列由本行自身给出；Halo 行越过上下边界时按拓扑取值：
+ * 环面直接绕回，克莱因瓶在奇数次越界时左右翻转整行 (规则在镜像下不变，翻转的行按镜像演化)，
+ * 有界平面边界外的行恒为 0、不参与计算。
+ * 交叉帽左右相接时上下翻转，幽灵列来自另一条带，无法在条带内独立推进，因此不支持。
+ *
+ * 只处理两态的 3x3 规则 (全和或非全和)；Generations 与 Larger than Life 规则仍需逐代演化。
+ */
+class TemporalBlocker {
+public:
+    static constexpr int DEFAULT_DEPTH = 8; ///< 默认每次读入后推进的代数
+    static constexpr int MAX_DEPTH = 32; ///< 允许设置的最大代数
+    static constexpr size_t BAND_CACHE_BYTES = 128 * 1024; ///< 单个条带两块本地缓冲的目标大小 (约为 L2 的一部分)
+
+    TemporalBlocker();
+
+    /**
+     * @brief 当前拓扑与规则能否使用时间分块
+     */
+    static bool IsSupported(BoundaryTopology topology, const CompiledRule &rule);
+
+    /**
+     * @brief 设置每次读入条带后连续推进的代数 (限制在 [1, MAX_DEPTH])
+     */
+    void SetDepth(int depth);
+
+    int GetDepth() const { return m_depth; }
+
+    /**
+     * @brief 把 grid 推进 generations 代
+     *
+     * 每一轮 (至多 depth 代) 从 grid 读、向 scratch 写，各条带由线程池并行计算，结束后交换两者。
+     * 结果与逐代调用行内核逐位一致。
+     * 中间各代只存在于条带缓冲中，出生/死亡数在条带内逐代统计，与逐代演化的计数相同。
+     * @param kernels 细胞计数使用的函数表 (与选出 stepRow 的函数表一致)
+     * @param pool 线程池
+     * @param stepRow 行内核
+     * @param topology 边界拓扑 (IsSupported 必须为 true)
+     * @param grid 当前代网格，返回时为推进后的网格
+     * @param scratch 与 grid 同尺寸的后缓冲 (内容会被覆盖)
+     * @param generations 推进的代数
+     * @param rule 预编译规则
+     * @param counts 可选：输出推进后的种群数与各代累计的出生/死亡数 (为 nullptr 时不统计)
+     */
+    void Run(const KernelTable &kernels, ThreadPool &pool, StepRowFn stepRow, BoundaryTopology topology, BitGrid &grid, BitGrid &scratch,
+             int generations, const CompiledRule &rule, CellCounts *counts = nullptr);
+
+private:
+    /**
+     * @brief 本地缓冲 (每个条带一组，跨调用复用)
+     */
+    struct BandBuffer {
+        BitGrid front; ///< 当前代
+        BitGrid back; ///< 下一代
+        std::vector<unsigned char> dead; ///< 本地行是否位于有界平面之外 (恒为 0)
+        CellCounts counts; ///< 本轮各代的出生/死亡数之和与最后一代的人口
+    };
+
+    /**
+     * @brief 读入一个条带，推进 depth 代，写回 dst 的 [firstRow, lastRow)
+     * @param countCells 为 true 时每推进一代都比较条带本身各行的前后两代，计入 buffer.counts
+     */
+    void StepBand(const KernelTable &kernels, BandBuffer &buffer, StepRowFn stepRow, BoundaryTopology topology, const BitGrid &src,
+                  BitGrid &dst, int firstRow, int lastRow, int depth, const CompiledRule &rule,
+                  bool countCells) const;
+
+    /**
+     * @brief 按网格尺寸、推进代数与线程数选择条带高度
+     */
+    int ChooseBandRows(const BitGrid &grid, int depth, int threadCount) const;
+
+    int m_depth; ///< 每轮推进的代数
+    std::vector<BandBuffer> m_buffers; ///< 各条带的本地缓冲
+};
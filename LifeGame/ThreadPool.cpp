@@ -0,0 +1,183 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : m_task(nullptr), m_taskCount(0), m_nextTask(0), m_stealing(false), m_pendingWorkers(0), m_batch(0),
+      m_stopping(false) {
+    Start(threadCount - 1);
+}
+
+ThreadPool::~ThreadPool() {
+    Stop();
+}
+
+void ThreadPool::SetThreadCount(int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount == GetThreadCount()) return;
+    Stop();
+    Start(threadCount - 1);
+}
+
+int ThreadPool::GetHardwareThreadCount() {
+    const unsigned int n = std::thread::hardware_concurrency();
+    return n > 0 ? static_cast<int>(n) : 1;
+}
+
+void ThreadPool::Start(int workerCount) {
+    m_stopping = false;
+    m_queues.clear();
+    for (int i = 0; i < workerCount + 1; ++i) {
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i + 1, m_batch);
+    }
+}
+
+void ThreadPool::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    for (std::thread &worker: m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+/**
+ * @brief 并行执行一批任务
+ *
+ * 调用线程同样领取任务，因此 N 个线程的池只有 N-1 个工作线程。
+ */
+void ThreadPool::Run(int taskCount, const std::function<void(int)> &task) {
+    if (taskCount <= 0) return;
+    if (m_workers.empty() || taskCount == 1) {
+        for (int i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    m_task = &task;
+    m_taskCount = taskCount;
+    m_nextTask.store(0);
+    m_stealing = false;
+    Dispatch();
+}
+
+/**
+ * @brief 以工作窃取方式执行一批任务
+ *
+ * 按优先级轮流分配：每个线程的队列头部都是它分到的最高优先级任务，
+ * 高代价任务先开始，低代价任务留在队尾，由先空闲的线程窃取来填补负载差。
+ */
+void ThreadPool::RunStealing(const std::vector<int> &tasks, const std::function<void(int)> &task) {
+    if (tasks.empty()) return;
+    if (m_workers.empty() || tasks.size() == 1) {
+        for (int t: tasks) {
+            task(t);
+        }
+        return;
+    }
+
+    const int threadCount = GetThreadCount();
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        m_queues[i % threadCount]->tasks.push_back(tasks[i]);
+    }
+    m_task = &task;
+    m_taskCount = static_cast<int>(tasks.size());
+    m_stealing = true;
+    Dispatch();
+}
+
+/**
+ * @brief 分派当前批次
+ *
+ * 批次参数在加锁递增批次序号之前写好，工作线程在锁内看到新序号后即可安全读取。
+ */
+void ThreadPool::Dispatch() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingWorkers = static_cast<int>(m_workers.size());
+        ++m_batch;
+    }
+    m_wakeCondition.notify_all();
+
+    RunTasks(0);
+
+    // 等待所有工作线程退出本批次，之后 task 引用才能失效
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_pendingWorkers == 0; });
+    m_task = nullptr;
+}
+
+/**
+ * @brief 工作线程主循环
+ *
+ * @param seenBatch 创建时的批次序号 (线程重建后不能把旧批次当成新任务)
+ */
+void ThreadPool::WorkerLoop(int threadIndex, unsigned long long seenBatch) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stopping || m_batch != seenBatch; });
+            if (m_stopping) return;
+            seenBatch = m_batch;
+        }
+
+        RunTasks(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pendingWorkers == 0) {
+                m_doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::RunTasks(int threadIndex) {
+    if (m_stealing) {
+        int task;
+        while (TakeTask(threadIndex, task)) {
+            (*m_task)(task);
+        }
+        return;
+    }
+
+    for (;;) {
+        const int i = m_nextTask.fetch_add(1);
+        if (i >= m_taskCount) break;
+        (*m_task)(i);
+    }
+}
+
+/**
+ * @brief 取一个任务
+ *
+ * 批次执行期间不会再加入新任务，因此所有队列都为空即表示任务已全部被领取。
+ */
+bool ThreadPool::TakeTask(int threadIndex, int &task) {
+    {
+        WorkQueue &own = *m_queues[threadIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    const int threadCount = static_cast<int>(m_queues.size());
+    for (int k = 1; k < threadCount; ++k) {
+        WorkQueue &victim = *m_queues[(threadIndex + k) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 常驻线程池
+ *
+ * 工作线程在构造时创建并一直保留，每一代演化只需唤醒一次，
+ * 避免每帧创建/销毁线程的开销。
+ *
+ * Run() 把 [0, taskCount) 个任务分给工作线程与调用线程共同执行，
+ * 任务下标通过原子计数器领取，全部完成后才返回。
+ * RunStealing() 则为每个线程维护一个双端队列：线程先处理自己队列中的任务，
+ * 空闲后从其它线程的队列尾部窃取，适合各任务耗时差别很大的情况。
+ * 线程数为 1 时不创建工作线程，所有任务在调用线程上按顺序执行。
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief 构造函数
+     * @param threadCount 参与计算的线程总数 (含调用线程)，小于 1 时按 1 处理
+     */
+    explicit ThreadPool(int threadCount = 1);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief 重新设置线程总数
+     *
+     * 会停止并重建所有工作线程，不能在 Run() 执行期间调用。
+     * @param threadCount 线程总数 (含调用线程)
+     */
+    void SetThreadCount(int threadCount);
+
+    /**
+     * @brief 获取线程总数 (含调用线程)
+     */
+    int GetThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    /**
+     * @brief 并行执行一批任务并等待完成
+     *
+     * @param taskCount 任务数量
+     * @param task 任务函数，参数为任务下标；不同下标的任务必须互不干扰
+     */
+    void Run(int taskCount, const std::function<void(int)> &task);
+
+    /**
+     * @brief 以工作窃取方式执行一批任务并等待完成
+     *
+     * tasks 应按优先级从高到低排列 (例如预计耗时从大到小)，依次轮流分到各线程的队列，
+     * 每个线程从自己队列的头部取任务，队列空了就从其它线程队列的尾部窃取。
+     * @param tasks 任务下标列表
+     * @param task 任务函数，参数为任务下标；不同下标的任务必须互不干扰
+     */
+    void RunStealing(const std::vector<int> &tasks, const std::function<void(int)> &task);
+
+    /**
+     * @brief 获取本机硬件线程数 (至少为 1)
+     */
+    static int GetHardwareThreadCount();
+
+private:
+    /**
+     * @brief 单个线程的任务队列
+     */
+    struct WorkQueue {
+        std::mutex mutex; ///< 保护 tasks
+        std::deque<int> tasks; ///< 待执行的任务下标
+    };
+
+    void Start(int workerCount);
+
+    void Stop();
+
+    void WorkerLoop(int threadIndex, unsigned long long seenBatch);
+
+    /**
+     * @brief 唤醒工作线程执行当前批次，调用线程也参与，全部完成后返回
+     */
+    void Dispatch();
+
+    /**
+     * @brief 领取并执行任务，直到任务全部被领取
+     * @param threadIndex 线程序号 (0 为调用线程)
+     */
+    void RunTasks(int threadIndex);
+
+    /**
+     * @brief 从自己的队列头部取任务，失败则从其它队列尾部窃取
+     */
+    bool TakeTask(int threadIndex, int &task);
+
+    std::vector<std::thread> m_workers; ///< 工作线程 (不含调用线程)
+    std::mutex m_mutex; ///< 保护下面的调度状态
+    std::condition_variable m_wakeCondition; ///< 通知工作线程有新批次
+    std::condition_variable m_doneCondition; ///< 通知调用线程批次完成
+
+    const std::function<void(int)> *m_task; ///< 当前批次的任务函数
+    int m_taskCount; ///< 当前批次的任务数量
+    std::atomic<int> m_nextTask; ///< 下一个待领取的任务下标 (Run 模式)
+    bool m_stealing; ///< 当前批次是否为工作窃取模式
+    std::vector<std::unique_ptr<WorkQueue> > m_queues; ///< 每个线程一个任务队列 (工作窃取模式)
+    int m_pendingWorkers; ///< 尚未完成当前批次的工作线程数
+    unsigned long long m_batch; ///< 批次序号，工作线程据此判断是否有新任务
+    bool m_stopping; ///< 是否正在停止
+};
@@ -0,0 +1,166 @@
+#include "TileScheduler.h"
+#include <algorithm>
+#include <chrono>
+
+TileScheduler::TileScheduler()
+    : m_topology(BoundaryTopology::Torus), m_tilesX(0), m_tilesY(0), m_width(0), m_height(0) {
+}
+
+/**
+ * @brief 重新划分分块
+ *
+ * 新网格内容未知，所有分块都标记为已变化。
+ */
+void TileScheduler::Resize(int width, int height) {
+    const int wordsPerRow = BitGrid::WordsForWidth(width);
+    m_width = width;
+    m_height = height;
+    m_tilesX = (wordsPerRow + TILE_WORDS - 1) / TILE_WORDS;
+    m_tilesY = (height + TILE_ROWS - 1) / TILE_ROWS;
+
+    m_tiles.clear();
+    for (int y = 0; y < height; y += TILE_ROWS) {
+        for (int w = 0; w < wordsPerRow; w += TILE_WORDS) {
+            Tile tile;
+            tile.firstRow = y;
+            tile.lastRow = std::min(y + TILE_ROWS, height);
+            tile.firstWord = w;
+            tile.lastWord = std::min(w + TILE_WORDS, wordsPerRow);
+            tile.index = static_cast<int>(m_tiles.size());
+            m_tiles.push_back(tile);
+        }
+    }
+
+    m_costs.assign(m_tiles.size(), 0);
+    m_order.resize(m_tiles.size());
+    for (size_t i = 0; i < m_order.size(); ++i) {
+        m_order[i] = static_cast<int>(i);
+    }
+
+    m_changed.assign(m_tiles.size(), 1);
+    m_nextChanged.assign(m_tiles.size(), 0);
+    m_rowActive.assign(m_tiles.size(), 0);
+    m_active.clear();
+}
+
+void TileScheduler::SetTopology(BoundaryTopology topology) {
+    m_topology = topology;
+    MarkAllDirty();
+}
+
+void TileScheduler::MarkAllDirty() {
+    std::fill(m_changed.begin(), m_changed.end(), 1);
+}
+
+void TileScheduler::MarkDirty(int x, int y, int w, int h) {
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + w, m_width);
+    const int y1 = std::min(y + h, m_height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int ty = y0 / TILE_ROWS; ty <= (y1 - 1) / TILE_ROWS; ++ty) {
+        for (int tx = x0 / TILE_CELLS; tx <= (x1 - 1) / TILE_CELLS; ++tx) {
+            m_changed[ty * m_tilesX + tx] = 1;
+        }
+    }
+}
+
+/**
+ * @brief 求出本代需要计算的分块
+ *
+ * 先在行内做左右膨胀，再在列方向做上下膨胀。
+ * 环面两个方向都环绕，克莱因瓶只有左右直接环绕，有界平面不环绕。
+ * 克莱因瓶与交叉帽在翻转的边上，相邻分块位于对边的镜像位置：
+ * 这里保守处理，只要任何一个边界分块变化，所有边界分块都重新计算。
+ */
+void TileScheduler::CollectActiveTiles() {
+    const bool wrapX = m_topology == BoundaryTopology::Torus || m_topology == BoundaryTopology::KleinBottle;
+    const bool wrapY = m_topology == BoundaryTopology::Torus;
+    const bool twisted = m_topology == BoundaryTopology::KleinBottle ||
+                         m_topology == BoundaryTopology::CrossSurface;
+
+    bool edgeChanged = false;
+    if (twisted) {
+        for (int ty = 0; ty < m_tilesY && !edgeChanged; ++ty) {
+            for (int tx = 0; tx < m_tilesX; ++tx) {
+                const bool edge = tx == 0 || ty == 0 || tx == m_tilesX - 1 || ty == m_tilesY - 1;
+                if (edge && m_changed[ty * m_tilesX + tx]) {
+                    edgeChanged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // 越过边界且不环绕时，用自身代替不存在的相邻分块
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        const uint8_t *row = &m_changed[ty * m_tilesX];
+        uint8_t *out = &m_rowActive[ty * m_tilesX];
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            const int west = tx > 0 ? tx - 1 : (wrapX ? m_tilesX - 1 : tx);
+            const int east = tx + 1 < m_tilesX ? tx + 1 : (wrapX ? 0 : tx);
+            out[tx] = row[west] | row[tx] | row[east];
+        }
+    }
+
+    m_active.clear();
+    for (int ty = 0; ty < m_tilesY; ++ty) {
+        const int northY = ty > 0 ? ty - 1 : (wrapY ? m_tilesY - 1 : ty);
+        const int southY = ty + 1 < m_tilesY ? ty + 1 : (wrapY ? 0 : ty);
+        const uint8_t *north = &m_rowActive[northY * m_tilesX];
+        const uint8_t *row = &m_rowActive[ty * m_tilesX];
+        const uint8_t *south = &m_rowActive[southY * m_tilesX];
+        const bool edgeRow = ty == 0 || ty == m_tilesY - 1;
+        for (int tx = 0; tx < m_tilesX; ++tx) {
+            const bool edge = edgeRow || tx == 0 || tx == m_tilesX - 1;
+            if ((north[tx] | row[tx] | south[tx]) || (edgeChanged && edge)) {
+                m_active.push_back(ty * m_tilesX + tx);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 处理所有分块
+ *
+ * 每个分块只由一个线程处理，耗时写回各自的 m_costs[i]，不需要加锁。
+ */
+void TileScheduler::Run(ThreadPool &pool, const std::function<bool(const Tile &)> &fn) {
+    CollectActiveTiles();
+    std::fill(m_nextChanged.begin(), m_nextChanged.end(), 0);
+
+    if (pool.GetThreadCount() == 1) {
+        for (int index: m_active) {
+            m_nextChanged[index] = fn(m_tiles[index]) ? 1 : 0;
+        }
+        m_changed.swap(m_nextChanged);
+        return;
+    }
+
+    // 按上一代的耗时从高到低排序 (稳定排序：耗时相同时保持行优先顺序)，只保留本代活跃的分块
+    std::stable_sort(m_order.begin(), m_order.end(), [this](int a, int b) {
+        return m_costs[a] > m_costs[b];
+    });
+    std::vector<uint8_t> &isActive = m_rowActive; // 膨胀结果已用完，复用为活跃标记
+    std::fill(isActive.begin(), isActive.end(), 0);
+    for (int index: m_active) {
+        isActive[index] = 1;
+    }
+    m_active.clear();
+    for (int index: m_order) {
+        if (isActive[index]) m_active.push_back(index);
+    }
+
+    pool.RunStealing(m_active, [&](int index) {
+        const auto start = std::chrono::steady_clock::now();
+        m_nextChanged[index] = fn(m_tiles[index]) ? 1 : 0;
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        // 指数平滑 (新旧各占一半)，避免单次抖动打乱排序
+        const uint32_t sample = static_cast<uint32_t>(std::min<long long>(elapsed, UINT32_MAX));
+        m_costs[index] = static_cast<uint32_t>((static_cast<uint64_t>(m_costs[index]) + sample) / 2);
+    });
+    m_changed.swap(m_nextChanged);
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "BitGrid.h"
+#include "ThreadPool.h"
+#include "Topology.h"
+
+/**
+ * @brief 网格分块
+ *
+ * 行范围 [firstRow, lastRow)，字范围 [firstWord, lastWord)。
+ */
+struct Tile {
+    int firstRow;
+    int lastRow;
+    int firstWord;
+    int lastWord;
+    int index; ///< 分块下标 (行优先)
+};
+
+/**
+ * @brief 分块调度器
+ *
+ * 把网格切成固定大小的分块 (TILE_WORDS 个字宽 x TILE_ROWS 行高)，
+ * 通过线程池的工作窃取模式并行处理。
+ *
+ * 每个分块的实际耗时会被记录下来 (指数平滑)，下一代按耗时从高到低排序后再分派，
+ * 让最昂贵的分块最先开始 (LPT 调度)。
+ * 棋盘上活跃区域往往集中在少数位置，这样比固定的水平条带更容易均衡负载。
+ *
+ * 同时记录每个分块 "上一代是否变化"。一个分块的下一代只取决于它自己与 8 个相邻分块，
+ * 如果这 9 个分块上一代都没有变化，它这一代也不会变化，可以直接跳过。
+ * 越过网格边界的相邻关系由边界拓扑决定 (见 SetTopology)。
+ * 跳过依赖双缓冲的不变量：未变化的分块在前、后缓冲中内容相同，
+ * 因此什么都不写，交换缓冲后结果依然正确。
+ * 外部直接修改前缓冲 (编辑、放置图案等) 时必须调用 MarkDirty 打破这个假设。
+ */
+class TileScheduler {
+public:
+    static constexpr int TILE_WORDS = 4; ///< 分块宽度 (字)，即 256 个细胞，正好一个 AVX2 向量
+    static constexpr int TILE_ROWS = 64; ///< 分块高度 (行)
+    static constexpr int TILE_CELLS = TILE_WORDS * 64; ///< 分块宽度 (细胞)
+
+    TileScheduler();
+
+    /**
+     * @brief 按网格尺寸重新划分分块，清空耗时记录并把所有分块标记为已变化
+     * @param width 网格宽度
+     * @param height 网格高度
+     */
+    void Resize(int width, int height);
+
+    /**
+     * @brief 设置边界拓扑 (决定越过边界的分块相邻关系)，并把所有分块标记为已变化
+     */
+    void SetTopology(BoundaryTopology topology);
+
+    /**
+     * @brief 处理本代需要重新计算的分块
+     *
+     * 只处理自身或相邻分块 (按边界拓扑) 上一代发生过变化的分块。
+     * 线程池只有 1 个线程时按行优先顺序串行执行，也不计时。
+     * @param pool 线程池
+     * @param fn 分块处理函数，返回该分块是否发生变化；不同分块的处理必须互不干扰
+     */
+    void Run(ThreadPool &pool, const std::function<bool(const Tile &)> &fn);
+
+    /**
+     * @brief 把所有分块标记为已变化 (下一代全部重新计算)
+     */
+    void MarkAllDirty();
+
+    /**
+     * @brief 把覆盖细胞矩形 (x, y, w, h) 的分块标记为已变化
+     *
+     * 矩形会被裁剪到网格范围内。
+     */
+    void MarkDirty(int x, int y, int w, int h);
+
+    /**
+     * @brief 把细胞 (x, y) 所在的分块标记为已变化 (不做边界检查)
+     */
+    void MarkCellDirty(int x, int y) {
+        m_changed[(y / TILE_ROWS) * m_tilesX + (x / TILE_CELLS)] = 1;
+    }
+
+    int GetTileCount() const { return static_cast<int>(m_tiles.size()); }
+
+    /**
+     * @brief 获取上一次 Run 实际计算的分块数
+     */
+    int GetActiveTileCount() const { return static_cast<int>(m_active.size()); }
+
+    /**
+     * @brief 分块在上一次 Run 中是否变化 (之后被标记为脏的分块也返回 true)
+     */
+    bool HasTileChanged(int index) const { return m_changed[index] != 0; }
+
+    const std::vector<Tile> &GetTiles() const { return m_tiles; }
+
+    /**
+     * @brief 获取分块最近的平滑耗时 (纳秒)
+     */
+    uint32_t GetTileCost(int index) const { return m_costs[index]; }
+
+private:
+    /**
+     * @brief 根据上一代的变化标记求出本代需要计算的分块 (3x3 膨胀)
+     */
+    void CollectActiveTiles();
+
+    BoundaryTopology m_topology; ///< 边界拓扑
+    int m_tilesX; ///< 每行分块数
+    int m_tilesY; ///< 每列分块数
+    int m_width; ///< 网格宽度 (细胞)
+    int m_height; ///< 网格高度
+    std::vector<Tile> m_tiles; ///< 所有分块 (行优先)
+    std::vector<uint8_t> m_changed; ///< 上一代各分块是否变化 (含被标记为脏的分块)
+    std::vector<uint8_t> m_nextChanged; ///< 本代各分块是否变化 (由各任务写入各自的元素)
+    std::vector<uint8_t> m_rowActive; ///< 水平膨胀的中间结果
+    std::vector<int> m_active; ///< 本代需要计算的分块 (按分派顺序)
+    std::vector<uint32_t> m_costs; ///< 每个分块的平滑耗时 (纳秒)，供下一代排序
+    std::vector<int> m_order; ///< 本代的分派顺序 (分块下标)
+};
@@ -0,0 +1,16 @@
+#include "Topology.h"
+
+/**
+ * @brief 按拓扑刷新幽灵细胞
+ *
+ * 运行时的拓扑选择只在这里分派一次，每种拓扑各自实例化一份 Build。
+ */
+void BoundaryHalo::Refresh(BoundaryTopology topology, const BitGrid &src) {
+    switch (topology) {
+        case BoundaryTopology::Torus: Build<TorusTopology>(src); return;
+        case BoundaryTopology::DeadEdge: Build<DeadEdgeTopology>(src); return;
+        case BoundaryTopology::KleinBottle: Build<KleinBottleTopology>(src); return;
+        case BoundaryTopology::CrossSurface: Build<CrossSurfaceTopology>(src); return;
+    }
+    Build<TorusTopology>(src);
+}
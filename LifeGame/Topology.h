@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BitGrid.h"
+#include "LifeKernel.h"
+
+/**
+ * @brief 网格边界拓扑
+ */
+enum class BoundaryTopology {
+    Torus, ///< 环面：左右、上下各自直接相接
+    DeadEdge, ///< 有界平面：边界外恒为死细胞
+    KleinBottle, ///< 克莱因瓶：左右直接相接，上下相接时左右翻转
+    CrossSurface ///< 交叉帽 (射影平面)：左右相接时上下翻转，上下相接时左右翻转
+};
+
+/**
+ * @brief 把坐标折回 [0, n)，并给出越过边界的次数 (向下取整，可为负)
+ */
+inline int WrapCoordinate(int v, int n, int &turns) {
+    turns = v >= 0 ? v / n : -((-v - 1) / n) - 1;
+    return v - turns * n;
+}
+
+/**
+ * @brief 边界拓扑策略
+ *
+ * 每种拓扑提供 Map：把网格外的坐标映射回网格内。
+ * 普通 3x3 规则只用到网格外一圈；Larger than Life 规则的邻域可能越过边界多次 (半径大于网格尺寸)，
+ * 每越过一次扭转边界就翻转一次。返回 false 表示该位置恒为死细胞。
+ * 这些函数只在每代刷新一次幽灵细胞时调用，演化内核本身不含任何取模或边界判断。
+ */
+struct TorusTopology {
+    static bool Map(int &x, int &y, int width, int height) {
+        int turns;
+        x = WrapCoordinate(x, width, turns);
+        y = WrapCoordinate(y, height, turns);
+        return true;
+    }
+};
+
+struct DeadEdgeTopology {
+    static bool Map(int &, int &, int, int) {
+        return false;
+    }
+};
+
+struct KleinBottleTopology {
+    static bool Map(int &x, int &y, int width, int height) {
+        int turns;
+        y = WrapCoordinate(y, height, turns);
+        if (turns & 1) x = width - 1 - x;
+        x = WrapCoordinate(x, width, turns);
+        return true;
+    }
+};
+
+struct CrossSurfaceTopology {
+    static bool Map(int &x, int &y, int width, int height) {
+        int turns;
+        x = WrapCoordinate(x, width, turns);
+        if (turns & 1) y = height - 1 - y;
+        y = WrapCoordinate(y, height, turns);
+        if (turns & 1) x = width - 1 - x;
+        return true;
+    }
+};
+
+/**
+ * @brief 网格外一圈的幽灵细胞 (Ghost Cells)
+ *
+ * 每代演化前按当前拓扑刷新一次：
+ * - 幽灵行：第 -1 行与第 height 行，按字存储，作为首行/末行的上/下邻行直接交给行内核；
+ * - 幽灵列：第 -1 列与第 width 列，按行打包为 GhostCells，行内核在行首/行尾字移位时补入。
+ * 这样行内核与分块计算只读现成的数据，环绕方式完全由刷新时使用的拓扑策略决定。
+ */
+class BoundaryHalo {
+public:
+    /**
+     * @brief 按拓扑刷新幽灵细胞 (根据 src 的尺寸自动调整缓冲区)
+     */
+    void Refresh(BoundaryTopology topology, const BitGrid &src);
+
+    /**
+     * @brief 按编译期拓扑策略刷新幽灵细胞
+     */
+    template <class Topology>
+    void Build(const BitGrid &src);
+
+    /**
+     * @brief 获取第 y 行的上邻行 (y 为 0 时是幽灵行)
+     */
+    const uint64_t *GetAbove(const BitGrid &src, int y) const {
+        return y > 0 ? src.GetRow(y - 1) : m_topRow.data();
+    }
+
+    /**
+     * @brief 获取第 y 行的下邻行 (y 为最后一行时是幽灵行)
+     */
+    const uint64_t *GetBelow(const BitGrid &src, int y) const {
+        return y + 1 < src.GetHeight() ? src.GetRow(y + 1) : m_bottomRow.data();
+    }
+
+    /**
+     * @brief 获取第 y 行计算时需要的幽灵列细胞
+     */
+    GhostCells GetGhosts(int y) const { return m_ghosts[y]; }
+
+private:
+    std::vector<uint64_t> m_topRow; ///< 第 -1 行
+    std::vector<uint64_t> m_bottomRow; ///< 第 height 行
+    std::vector<GhostCells> m_ghosts; ///< 每行的幽灵列细胞 (含上下相邻行)
+    std::vector<uint8_t> m_westColumn; ///< 第 -1 列，下标 y + 1 (y 属于 [-1, height])
+    std::vector<uint8_t> m_eastColumn; ///< 第 width 列，下标同上
+};
+
+template <class Topology>
+void BoundaryHalo::Build(const BitGrid &src) {
+    const int width = src.GetWidth();
+    const int height = src.GetHeight();
+    const int words = src.GetStride();
+
+    auto cell = [&](int x, int y) -> bool {
+        if (x >= 0 && x < width && y >= 0 && y < height) return src.Get(x, y);
+        if (!Topology::Map(x, y, width, height)) return false;
+        return src.Get(x, y);
+    };
+
+    m_topRow.assign(words, 0);
+    m_bottomRow.assign(words, 0);
+    for (int x = 0; x < width; ++x) {
+        if (cell(x, -1)) m_topRow[x >> 6] |= 1ULL << (x & 63);
+        if (cell(x, height)) m_bottomRow[x >> 6] |= 1ULL << (x & 63);
+    }
+
+    m_westColumn.resize(height + 2);
+    m_eastColumn.resize(height + 2);
+    for (int y = -1; y <= height; ++y) {
+        m_westColumn[y + 1] = cell(-1, y) ? 1 : 0;
+        m_eastColumn[y + 1] = cell(width, y) ? 1 : 0;
+    }
+
+    m_ghosts.resize(height);
+    for (int y = 0; y < height; ++y) {
+        GhostCells &g = m_ghosts[y];
+        g.west = static_cast<uint8_t>(m_westColumn[y] | (m_westColumn[y + 1] << 1) | (m_westColumn[y + 2] << 2));
+        g.east = static_cast<uint8_t>(m_eastColumn[y] | (m_eastColumn[y + 1] << 1) | (m_eastColumn[y + 2] << 2));
+    }
+}
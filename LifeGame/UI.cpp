@@ -399,9 +399,9 @@ void UI::LayoutControls(int clientWidth, int clientHeight) {
  */
 void UI::UpdateWindowTitle(HWND hWnd, const LifeGame &game) {
     TCHAR title[200];
-    _stprintf_s(title, TEXT("LifeGame (Win32 GDI) - %s | 速度：%d ms/帧"),
+    _stprintf_s(title, TEXT("LifeGame (Win32 GDI) - %s | 速度：%d ms/帧，%d 代/帧"),
                 game.IsRunning() ? TEXT("运行中") : TEXT("已暂停"),
-                game.GetSpeed());
+                game.GetSpeed(), game.GetGenerationsPerTick());
     SetWindowText(hWnd, title);
 }
 
@@ -446,13 +446,13 @@ void UI::HandleCommand(int id, int code, HWND hWnd, LifeGame &game, Renderer *pR
             if (v > 0) newCols = v;
         }
 
-        // 限制范围，防止过大或过小
-        if (newCols < 4) newCols = 4;
-        if (newRows < 4) newRows = 4;
-        if (newCols > 400) newCols = 400; // 扩大上限
-        if (newRows > 300) newRows = 300;
+        // 限制下限；上限由内存预算决定 (见 LifeGame::ResizeGrid)
+        if (newCols < LifeGame::MIN_GRID_SIZE) newCols = LifeGame::MIN_GRID_SIZE;
+        if (newRows < LifeGame::MIN_GRID_SIZE) newRows = LifeGame::MIN_GRID_SIZE;
 
-        game.ResizeGrid(newCols, newRows);
+        if (!game.ResizeGrid(newCols, newRows)) {
+            MessageBox(hWnd, TEXT("网格过大，超出内存预算！"), TEXT("错误"), MB_OK | MB_ICONERROR);
+        }
         if (pRenderer) pRenderer->ClearVisuals(); // 清除视觉残留
 
         // 更新输入框显示 (可能被修正过)
@@ -467,8 +467,9 @@ void UI::HandleCommand(int id, int code, HWND hWnd, LifeGame &game, Renderer *pR
     // 3. 演化规则改变
     else if (id == ID_RULE_COMBO && code == CBN_SELCHANGE) {
         int sel = static_cast<int>(SendMessage(m_hRuleCombo, CB_GETCURSEL, 0, 0));
-        if (sel >= 0) {
-            game.SetRule(sel);
+        if (sel >= 0 && !game.SetRule(sel)) {
+            MessageBox(hWnd, TEXT("该规则在当前网格尺寸下超出内存预算！"), TEXT("错误"), MB_OK | MB_ICONERROR);
+            SendMessage(m_hRuleCombo, CB_SETCURSEL, game.GetRuleIndex(), 0); // 恢复为仍在使用的规则
         }
         SetFocus(hWnd); // 自动聚焦回主窗口
     }
@@ -494,7 +495,9 @@ void UI::HandleCommand(int id, int code, HWND hWnd, LifeGame &game, Renderer *pR
             h = 2000;
         }
 
-        game.ResizeGrid(w, h);
+        if (!game.ResizeGrid(w, h)) {
+            MessageBox(hWnd, TEXT("网格过大，超出内存预算！"), TEXT("错误"), MB_OK | MB_ICONERROR);
+        }
         if (pRenderer) {
             pRenderer->ClearVisuals();
             // 重置视图位置和缩放
@@ -569,6 +572,14 @@ void UI::HandleCommand(int id, int code, HWND hWnd, LifeGame &game, Renderer *pR
                 _stprintf_s(buf, TEXT("%d"), game.GetWidth());
                 SetWindowText(m_hColsEdit, buf);
 
+                // 存档中的规则可能是新加入的自定义规则，补齐下拉框后选中当前规则
+                const std::vector<RuleData> &rules = game.GetRuleEngine().GetRules();
+                for (int i = static_cast<int>(SendMessage(m_hRuleCombo, CB_GETCOUNT, 0, 0));
+                     i < static_cast<int>(rules.size()); ++i) {
+                    SendMessage(m_hRuleCombo, CB_ADDSTRING, 0, (LPARAM) rules[i].name.c_str());
+                }
+                SendMessage(m_hRuleCombo, CB_SETCURSEL, game.GetRuleIndex(), 0);
+
                 InvalidateRect(hWnd, nullptr, TRUE);
                 MessageBox(hWnd, TEXT("加载成功！"), TEXT("提示"), MB_OK | MB_ICONINFORMATION);
             } else {
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief xoshiro256** 伪随机数生成器
+ *
+ * 每次产生 64 个高质量随机位，状态只有 4 个字，比 rand() 快得多，且同一种子在任何平台上序列相同。
+ * 种子经 SplitMix64 展开为初始状态 (保证状态不全为 0)。
+ */
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+    /**
+     * @brief 用 64 位种子重置生成器
+     */
+    void Seed(uint64_t seed) {
+        for (uint64_t &word: m_state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @brief 产生下一个 64 位随机数
+     */
+    uint64_t Next() {
+        const uint64_t result = RotateLeft(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = RotateLeft(m_state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief 产生 64 个独立的随机位，每一位为 1 的概率是 threshold / 256
+     *
+     * 把概率的二进制小数逐位与随机字合并 (从最低位开始：该位为 1 取或，为 0 取与)，
+     * 相当于 64 个细胞同时比较 "随机数 < 概率"。末尾的 0 位不影响结果，因此密度 0.5 只需一次抽取，
+     * 最多 8 次。
+     * @param threshold 概率的 8 位定点表示 (0 - 256，256 表示全 1)
+     */
+    uint64_t NextBernoulli(unsigned threshold) {
+        if (threshold == 0) return 0;
+        if (threshold >= 256) return ~0ULL;
+        int position = 0; // 当前处理的是小数点后第 8 - position 位
+        while ((threshold & 1u) == 0) {
+            threshold >>= 1;
+            position++;
+        }
+        uint64_t bits = Next();
+        for (position++, threshold >>= 1; position < 8; position++, threshold >>= 1) {
+            bits = (threshold & 1u) ? (bits | Next()) : (bits & Next());
+        }
+        return bits;
+    }
+
+    /**
+     * @brief 把 [0, 1] 的密度换算为 NextBernoulli 的阈值 (四舍五入到 1/256)
+     */
+    static unsigned DensityToThreshold(float density) {
+        if (!(density > 0.0f)) return 0;
+        if (density >= 1.0f) return 256;
+        return static_cast<unsigned>(density * 256.0f + 0.5f);
+    }
+
+private:
+    static uint64_t RotateLeft(uint64_t v, int k) { return (v << k) | (v >> (64 - k)); }
+
+    uint64_t m_state[4]; ///< 生成器状态
+};